@@ -0,0 +1,115 @@
+#ifndef NETXTEN_UTILS_FILE_FOLLOWER_HPP
+#define NETXTEN_UTILS_FILE_FOLLOWER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <test_repo/export_macros.hpp>
+
+namespace netxten::utils {
+
+/**
+ * @brief Reads a file that is still being written, like tail -f.
+ *
+ * At the end of the file, read() waits for the writer to append more data instead of
+ * reporting the end, so a demuxer reading through it never sees a truncated packet.
+ * The end is only reported once the file has stopped growing for the idle timeout or
+ * the stop flag is set.
+ */
+class SAMPLE_LIBRARY_API FileFollower
+{
+public:
+  /**
+   * @brief How the follower waits for new data.
+   */
+  struct Options
+  {
+    /// Longest wait between two checks for new data, in seconds. Also bounds how long a
+    /// waiting read takes to notice the stop flag.
+    double poll_interval = 0.05;
+
+    /// Wake up as soon as the file is written, through inotify, instead of sleeping for
+    /// poll_interval. Only available on Linux; elsewhere the file is polled.
+    bool use_inotify = true;
+
+    /// Report the end of the file once it has not grown for this many seconds; 0 waits
+    /// until the stop flag is set.
+    double idle_timeout = 10.0;
+  };
+
+  /**
+   * @brief Opens the file for following.
+   *
+   * @param path The path to the file.
+   * @param options The wait options.
+   * @param stop Flag that makes waiting reads report the end of the file; must outlive
+   * the follower.
+   * @throws std::runtime_error if the file cannot be opened.
+   */
+  FileFollower(const std::string &path, const Options &options, const std::atomic<bool> &stop);
+
+  /**
+   * @brief Closes the file.
+   */
+  ~FileFollower();
+
+  // Delete copy and move operations.
+  FileFollower(const FileFollower &) = delete;//*< Deleted copy constructor.
+  FileFollower &operator=(const FileFollower &) = delete;//*< Deleted copy assignment operator.
+  FileFollower(FileFollower &&) = delete;//*< Deleted move constructor.
+  FileFollower &operator=(FileFollower &&) = delete;//*< Deleted move assignment operator.
+
+  /**
+   * @brief Reads the next bytes, waiting for the writer at the end of the file.
+   *
+   * @param buffer The destination.
+   * @param size The maximum number of bytes to read.
+   * @return int The number of bytes read; 0 at the end of the followed file.
+   */
+  int read(uint8_t *buffer, int size);
+
+  /**
+   * @brief Reads the next bytes written so far, without waiting for the writer.
+   *
+   * @param buffer The destination.
+   * @param size The maximum number of bytes to read.
+   * @return int The number of bytes read; 0 at the current end of the file.
+   */
+  int readAvailable(uint8_t *buffer, int size);
+
+  /**
+   * @brief Moves the read position.
+   *
+   * @param offset The offset relative to whence.
+   * @param whence SEEK_SET, SEEK_CUR or SEEK_END.
+   * @return int64_t The new position, or -1 on failure.
+   */
+  int64_t seek(int64_t offset, int whence);
+
+  /**
+   * @brief Gets the current size of the file.
+   *
+   * @return int64_t The size in bytes, or -1 on failure.
+   */
+  [[nodiscard]] int64_t size() const;
+
+private:
+  /**
+   * @brief Waits until the file grows past the read position.
+   *
+   * @return true if new data is available, false on stop or idle timeout.
+   */
+  bool wait_for_data();
+
+  std::string m_path;//*< Path of the followed file.
+  Options m_options;//*< Wait options.
+  const std::atomic<bool> &m_stop;//*< Stop flag owned by the caller.
+  std::FILE *m_file = nullptr;//*< Open file.
+  int64_t m_position = 0;//*< Read position.
+  int m_inotify_fd = -1;//*< inotify instance, or -1 when polling.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_FILE_FOLLOWER_HPP */
@@ -2,6 +2,7 @@
 #define NEXTEN_CAMERA_FLIR_CAMERA_HPP
 
 #include "frame.hpp"
+#include "frame_view.hpp"
 #include <functional>
 #include <memory>
 #include <opencv2/opencv.hpp>
@@ -143,6 +144,17 @@ public:
    */
   std::pair<uint64_t, std::optional<cv::Mat>> getLatestFrame(uint64_t lastSeenFrame);
 
+  /**
+   * @brief Retrieve the latest camera frame as a reference-counted view.
+   *
+   * The view shares the image returned by getLatestFrame(); no pixels are copied.
+   *
+   * @param lastSeenFrame The frame identifier last seen by the caller.
+   * @return A pair containing the new frame identifier and a view of the image, whose
+   * metadata index is the frame identifier; the view is empty if no image is available.
+   */
+  std::pair<uint64_t, std::optional<netxten::types::FrameView>> getLatestFrameView(uint64_t lastSeenFrame);
+
   /**
    * @brief Retrieves the camera model name.
    *
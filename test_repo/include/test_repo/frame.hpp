@@ -11,6 +11,17 @@ using Vector16                   = Eigen::Matrix<uint16_t, Eigen::Dynamic, 1>;
 using FrameFloat                 = Frame<float>;
 using FrameDouble                = Frame<double>;
 
+/**
+ * @brief Frames in the row-major layout of decoded images and cv::Mat.
+ *
+ * Eigen allocates the storage of dynamic matrices aligned to EIGEN_MAX_ALIGN_BYTES, so
+ * these can be decoded into directly and processed with aligned SIMD loads, without the
+ * transpose that filling a column-major Frame from an image needs.
+ */
+template<typename T> using RowMajorFrame = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using RowMajorFrame16                    = RowMajorFrame<uint16_t>;
+using RowMajorFrameFloat                 = RowMajorFrame<float>;
+
 /**
  * @brief Structure to hold the height and width of a frame.
  *
@@ -21,6 +32,39 @@ struct FrameSize
   std::size_t width  = 0;//*< The width of the frame. */
 };
 
+/**
+ * @brief Pixel layouts a frame extractor can produce.
+ */
+enum class PixelFormat {
+  BGR24,///< Packed 8-bit blue, green, red.
+  GRAY8,///< 8-bit luma.
+  GRAY16,///< 16-bit luma in native byte order.
+  YUV420P///< Planar 8-bit YUV 4:2:0, Y, U and V planes stored back to back.
+};
+
+/**
+ * @brief Computes the size of a tightly packed frame buffer.
+ *
+ * @param format The pixel format of the buffer.
+ * @param size The frame size.
+ * @return constexpr std::size_t The buffer size in bytes.
+ */
+constexpr std::size_t frameBufferSize(PixelFormat format, FrameSize size)
+{
+  const std::size_t pixels = size.height * size.width;
+  switch (format) {
+  case PixelFormat::BGR24:
+    return pixels * 3;
+  case PixelFormat::GRAY8:
+    return pixels;
+  case PixelFormat::GRAY16:
+    return pixels * 2;
+  case PixelFormat::YUV420P:
+    return pixels + 2 * (((size.height + 1) / 2) * ((size.width + 1) / 2));
+  }
+  return 0;
+}
+
 struct FrameInfo
 {
   FrameSize size;//*< The size of the frame. */
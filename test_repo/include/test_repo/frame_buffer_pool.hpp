@@ -0,0 +1,142 @@
+#ifndef NETXTEN_UTILS_FRAME_BUFFER_POOL_HPP
+#define NETXTEN_UTILS_FRAME_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <test_repo/export_macros.hpp>
+#include <vector>
+
+namespace netxten::utils {
+
+class FrameGrabberBase;
+
+/**
+ * @brief Thread-safe pool of equally sized frame buffers.
+ *
+ * Buffers are handed out as leases that return the buffer to the pool when destroyed.
+ * Used with FrameGrabberBase::getFrameInto(), a consumer that holds at most N frames at
+ * a time allocates N buffers for a whole recording.
+ */
+class SAMPLE_LIBRARY_API FrameBufferPool
+{
+public:
+  /**
+   * @brief A buffer on loan from the pool; returned to it on destruction.
+   */
+  class SAMPLE_LIBRARY_API Buffer
+  {
+  public:
+    Buffer() = default;
+
+    /**
+     * @brief Returns the buffer to its pool.
+     */
+    ~Buffer();
+
+    Buffer(const Buffer &) = delete;
+    Buffer &operator=(const Buffer &) = delete;
+    Buffer(Buffer &&other) noexcept;
+    Buffer &operator=(Buffer &&other) noexcept;
+
+    /**
+     * @brief Gets the frame buffer.
+     *
+     * @return cv::Mat& The buffer, allocated with the pool's size and type.
+     */
+    [[nodiscard]] cv::Mat &mat() { return m_mat; }
+
+    /**
+     * @brief Gets the frame buffer.
+     *
+     * @return const cv::Mat& The buffer, allocated with the pool's size and type.
+     */
+    [[nodiscard]] const cv::Mat &mat() const { return m_mat; }
+
+  private:
+    friend class FrameBufferPool;
+
+    /**
+     * @brief Constructs a lease of a buffer.
+     *
+     * @param pool The pool to return the buffer to.
+     * @param mat The buffer.
+     */
+    Buffer(FrameBufferPool *pool, cv::Mat mat);
+
+    FrameBufferPool *m_pool = nullptr;//*< Owning pool, or nullptr for an empty lease.
+    cv::Mat m_mat;//*< The buffer.
+  };
+
+  /**
+   * @brief Pool counters.
+   */
+  struct Stats
+  {
+    size_t allocations = 0;///< Buffers allocated because none was idle.
+    size_t reuses = 0;///< Leases served from an idle buffer.
+    size_t idle = 0;///< Buffers currently waiting in the pool.
+  };
+
+  /**
+   * @brief Constructs an empty pool.
+   *
+   * @param rows The buffer height.
+   * @param cols The buffer width.
+   * @param type The OpenCV element type, e.g. CV_16U.
+   * @param max_idle Maximum number of returned buffers kept for reuse.
+   */
+  FrameBufferPool(int rows, int cols, int type, size_t max_idle = DEFAULT_MAX_IDLE);
+
+  /**
+   * @brief Constructs an empty pool for the 16-bit frames of a grabber.
+   *
+   * @param grabber An initialized grabber.
+   * @param max_idle Maximum number of returned buffers kept for reuse.
+   */
+  explicit FrameBufferPool(const FrameGrabberBase &grabber, size_t max_idle = DEFAULT_MAX_IDLE);
+
+  // Leases point back to the pool, so it cannot be copied or moved.
+  FrameBufferPool(const FrameBufferPool &) = delete;//*< Deleted copy constructor.
+  FrameBufferPool &operator=(const FrameBufferPool &) = delete;//*< Deleted copy assignment operator.
+  FrameBufferPool(FrameBufferPool &&) = delete;//*< Deleted move constructor.
+  FrameBufferPool &operator=(FrameBufferPool &&) = delete;//*< Deleted move assignment operator.
+
+  /**
+   * @brief Lends a buffer, reusing an idle one if possible.
+   *
+   * The pool must outlive the lease.
+   *
+   * @return Buffer The lease.
+   */
+  [[nodiscard]] Buffer acquire();
+
+  /**
+   * @brief Gets the pool counters.
+   *
+   * @return Stats The current statistics.
+   */
+  [[nodiscard]] Stats getStats() const;
+
+private:
+  static constexpr size_t DEFAULT_MAX_IDLE = 4;//*< Default number of idle buffers kept.
+
+  /**
+   * @brief Takes a buffer back; buffers whose size or type changed are dropped.
+   *
+   * @param mat The returned buffer.
+   */
+  void release(cv::Mat &&mat);
+
+  int m_rows = 0;//*< Buffer height.
+  int m_cols = 0;//*< Buffer width.
+  int m_type = 0;//*< Buffer element type.
+  size_t m_max_idle = DEFAULT_MAX_IDLE;//*< Maximum number of idle buffers.
+  mutable std::mutex m_mutex;//*< Guards the idle buffers and the statistics.
+  std::vector<cv::Mat> m_idle;//*< Buffers waiting to be reused.
+  Stats m_stats;//*< Pool counters.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_FRAME_BUFFER_POOL_HPP */
@@ -0,0 +1,126 @@
+#ifndef NETXTEN_UTILS_FRAME_CACHE_HPP
+#define NETXTEN_UTILS_FRAME_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <test_repo/export_macros.hpp>
+#include <vector>
+
+namespace netxten::utils {
+
+/**
+ * @brief Byte-budgeted cache of decoded frames keyed by frame number.
+ *
+ * Frames are copied into the cache, so callers keep ownership of their buffers. Memory of
+ * evicted frames is reused for later insertions. The cache is not thread-safe; it is
+ * owned by a single extractor.
+ */
+class SAMPLE_LIBRARY_API FrameCache
+{
+public:
+  /**
+   * @brief Selects the frame dropped when the cache exceeds its budget.
+   */
+  enum class EvictionPolicy {
+    LEAST_RECENTLY_USED,///< Drop the frame that was inserted or hit longest ago.
+    FARTHEST_FROM_LAST_ACCESS///< Drop the frame farthest from the last requested frame.
+  };
+
+  /**
+   * @brief Cache counters accumulated since construction or the last clear().
+   */
+  struct Stats
+  {
+    size_t hits = 0;///< Lookups served from the cache.
+    size_t misses = 0;///< Lookups that had to decode.
+    size_t insertions = 0;///< Frames stored.
+    size_t evictions = 0;///< Frames dropped to stay within the budget.
+    size_t entries = 0;///< Frames currently cached.
+    size_t bytes = 0;///< Bytes of frame data currently cached.
+  };
+
+  /**
+   * @brief Constructs an empty cache.
+   *
+   * @param byte_budget Maximum number of bytes of frame data kept.
+   * @param policy The eviction policy.
+   */
+  explicit FrameCache(size_t byte_budget, EvictionPolicy policy = EvictionPolicy::LEAST_RECENTLY_USED);
+
+  /**
+   * @brief Looks up a frame and counts the hit or miss.
+   *
+   * @param frame_number The frame to look up.
+   * @return const std::vector<uint8_t>* The cached frame data, valid until the next
+   * insert() or clear(), or nullptr on a miss.
+   */
+  const std::vector<uint8_t> *lookup(size_t frame_number);
+
+  /**
+   * @brief Checks whether a frame is cached without touching the statistics.
+   *
+   * @param frame_number The frame to look up.
+   * @return true if the frame is cached.
+   */
+  [[nodiscard]] bool contains(size_t frame_number) const;
+
+  /**
+   * @brief Stores a copy of a frame, evicting other frames to stay within the budget.
+   *
+   * Frames larger than the whole budget are not stored. An already cached frame is only
+   * refreshed in the eviction order.
+   *
+   * @param frame_number The frame number.
+   * @param data The frame data.
+   * @param size The frame size in bytes.
+   */
+  void insert(size_t frame_number, const uint8_t *data, size_t size);
+
+  /**
+   * @brief Drops all frames and resets the statistics.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the cache counters.
+   *
+   * @return Stats The current statistics.
+   */
+  [[nodiscard]] Stats getStats() const;
+
+  /**
+   * @brief Gets the byte budget.
+   *
+   * @return size_t The maximum number of bytes kept.
+   */
+  [[nodiscard]] size_t getBudget() const { return m_budget; }
+
+private:
+  /**
+   * @brief A cached frame and its position in the recency list.
+   */
+  struct Entry
+  {
+    std::vector<uint8_t> data;//*< Frame data.
+    std::list<size_t>::iterator recency;//*< Position in m_recency.
+  };
+
+  /**
+   * @brief Removes the frame selected by the eviction policy.
+   */
+  void evict_one();
+
+  size_t m_budget = 0;//*< Maximum number of bytes of frame data.
+  EvictionPolicy m_policy = EvictionPolicy::LEAST_RECENTLY_USED;//*< Eviction policy.
+  std::map<size_t, Entry> m_entries;//*< Cached frames ordered by frame number.
+  std::list<size_t> m_recency;//*< Frame numbers, most recently used first.
+  std::vector<uint8_t> m_spare;//*< Memory of the last evicted frame, reused by insert().
+  size_t m_last_access = 0;//*< Frame number of the last lookup.
+  Stats m_stats;//*< Cache counters.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_FRAME_CACHE_HPP */
@@ -2,7 +2,10 @@
 #define FRAME_GRABBER_BASE_HPP
 
 #include "camera_type.hpp"
+#include "frame_range.hpp"
+#include "frame_view.hpp"
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <opencv2/opencv.hpp>
@@ -35,6 +38,29 @@ protected:
    */
   virtual void setup() = 0;
 
+  /**
+   * @brief Called when a FrameRange starts reading frames in order.
+   *
+   * Grabbers that can read ahead override it to start doing so from the first frame. The
+   * default implementation does nothing.
+   *
+   * @param first The first frame the range reads.
+   * @param step The distance between two frames the range reads.
+   */
+  virtual void beginSequential(size_t first, size_t step) const;
+
+  /**
+   * @brief Reads the next frame of a FrameRange.
+   *
+   * The range has checked the initialization and the indices, so implementations skip
+   * those checks. The default implementation calls getFrameInto().
+   *
+   * @param index The index of the frame to retrieve; within the range of the grabber.
+   * @param frame Receives the 16-bit frame; its memory is reused between frames.
+   * @return true if the frame was retrieved.
+   */
+  virtual bool readSequential(size_t index, cv::Mat &frame) const;
+
 public:
   /**
    * @brief Constructor to initialize the frame grabber with a file path.
@@ -102,6 +128,112 @@ public:
    */
   [[nodiscard]] virtual cv::Mat getCvFrame(size_t index) const = 0;
 
+  /**
+   * @brief Retrieves a frame as an immutable, reference-counted view.
+   *
+   * The view can be shared between consumers and looked at as a cv::Mat, an Eigen map or
+   * raw rows without copying the pixels. The default implementation wraps the result of
+   * getCvFrame(); the metadata holds the index and, if the frame rate is known, the time.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return netxten::types::FrameView The frame; empty if it could not be retrieved.
+   */
+  [[nodiscard]] virtual netxten::types::FrameView getFrameView(size_t index) const;
+
+  /**
+   * @brief Retrieves a frame into a caller-provided cv::Mat.
+   *
+   * The frame is written into the existing allocation of frame when its size and type
+   * already match, so a consumer reusing one Mat, or leases from a FrameBufferPool, does
+   * not allocate per frame. The default implementation copies the result of getCvFrame().
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the frame; (re)allocated only if its size or type differ.
+   * @return true if the frame was retrieved.
+   */
+  virtual bool getFrameInto(size_t index, cv::Mat &frame) const;
+
+  /**
+   * @brief Retrieves a 16-bit frame into a caller-provided buffer.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param buffer The destination, rows times columns values in row-major order.
+   * @param size The number of values the buffer can hold.
+   * @return true if the frame was retrieved; false if it failed or the buffer is too small.
+   */
+  bool getFrameInto(size_t index, uint16_t *buffer, size_t size) const;
+
+  /**
+   * @brief Retrieves a 16-bit frame into a row-major Eigen matrix.
+   *
+   * The frame is decoded straight into the aligned storage of the matrix, in the layout
+   * of the image, so Eigen math can run on it without a copy or a transpose.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the frame; resized only if its size differs.
+   * @return true if the frame was retrieved.
+   */
+  bool getFrameInto(size_t index, netxten::types::RowMajorFrame16 &frame) const;
+
+  /**
+   * @brief Retrieves several frames as cv::Mat.
+   *
+   * The default implementation calls getCvFrame() for each index. Grabbers that can share
+   * decoding work between frames override it.
+   *
+   * @param indices The frames to retrieve, in any order; duplicates are allowed.
+   * @return std::vector<cv::Mat> The frames in the order of indices.
+   */
+  [[nodiscard]] virtual std::vector<cv::Mat> getCvFrames(const std::vector<size_t> &indices) const;
+
+  /**
+   * @brief Streams several frames to a callback in ascending index order.
+   *
+   * Each distinct index is delivered once, so the whole batch never has to be held in
+   * memory. The callback must not call back into the grabber.
+   *
+   * @param indices The frames to retrieve, in any order.
+   * @param callback Receives the index and the frame.
+   */
+  virtual void getCvFrames(const std::vector<size_t> &indices,
+    const std::function<void(size_t, const cv::Mat &)> &callback) const;
+
+  /**
+   * @brief Iterates over all frames in order.
+   *
+   * @return FrameRange The range, to be used in a range-based for loop.
+   * @throws std::runtime_error if the grabber is not initialized.
+   */
+  [[nodiscard]] FrameRange frames() const;
+
+  /**
+   * @brief Iterates over the frames from first up to, but excluding, last.
+   *
+   * @param first The first frame.
+   * @param last One past the last frame; clamped to the number of frames.
+   * @return FrameRange The range, to be used in a range-based for loop.
+   * @throws std::runtime_error if the grabber is not initialized.
+   * @throws std::out_of_range if first is past last.
+   */
+  [[nodiscard]] FrameRange frames(size_t first, size_t last) const;
+
+  /**
+   * @brief Iterates over every step-th frame from first up to, but excluding, last.
+   *
+   * Unlike a loop over getCvFrame(), the range declares that frames are read in order:
+   * the indices are checked once, every frame is decoded into the same buffer and
+   * grabbers can read ahead.
+   *
+   * @param first The first frame.
+   * @param last One past the last frame; clamped to the number of frames.
+   * @param step The distance between two frames.
+   * @return FrameRange The range, to be used in a range-based for loop.
+   * @throws std::runtime_error if the grabber is not initialized.
+   * @throws std::out_of_range if first is past last.
+   * @throws std::invalid_argument if step is 0.
+   */
+  [[nodiscard]] FrameRange frames(size_t first, size_t last, size_t step) const;
+
   /**
    * @brief Get the frame rate of the video.
    *
@@ -156,6 +288,8 @@ public:
   void checkInitialization() const;
 
 private:
+  friend class FrameRange;
+
   std::optional<double> m_frame_rate_opt = std::nullopt;//*< Optional frame rate */
   std::optional<std::string> m_camera_model_opt = std::nullopt;//*< Optional camera model */
   std::optional<netxten::types::CameraType> m_camera_type_opt = std::nullopt;//*< Optional camera type */
@@ -0,0 +1,179 @@
+#ifndef NETXTEN_UTILS_FRAME_RANGE_HPP
+#define NETXTEN_UTILS_FRAME_RANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <opencv2/core.hpp>
+#include <test_repo/export_macros.hpp>
+#include <utility>
+
+namespace netxten::utils {
+
+class FrameGrabberBase;
+
+/**
+ * @brief Single-pass range over evenly spaced frames of a grabber.
+ *
+ * Returned by FrameGrabberBase::frames(). The range is checked once when it is made and
+ * tells the grabber that frames are read in order, so the grabber can read ahead and skip
+ * its per-call checks. Every frame is written into one buffer owned by the range: the
+ * image an iterator refers to is overwritten by the next increment and must be cloned to
+ * be kept.
+ */
+class SAMPLE_LIBRARY_API FrameRange
+{
+public:
+  /**
+   * @brief Input iterator over the frames of the range.
+   */
+  class SAMPLE_LIBRARY_API Iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = cv::Mat;
+    using pointer = const cv::Mat *;
+    using reference = const cv::Mat &;
+
+    /**
+     * @brief Holds the frame an iterator referred to before a postfix increment.
+     */
+    class SAMPLE_LIBRARY_API Proxy
+    {
+    public:
+      /**
+       * @brief Gets the frame.
+       *
+       * @return const cv::Mat& A copy of the frame, which the increment does not overwrite.
+       */
+      const cv::Mat &operator*() const { return m_frame; }
+
+    private:
+      friend class Iterator;
+
+      explicit Proxy(cv::Mat frame) : m_frame(std::move(frame)) {}
+
+      cv::Mat m_frame;//*< Copy of the frame before the increment.
+    };
+
+    Iterator() = default;
+
+    /**
+     * @brief Gets the current frame.
+     *
+     * @return const cv::Mat& The 16-bit frame; empty if it could not be retrieved.
+     */
+    reference operator*() const;
+
+    /**
+     * @brief Accesses the current frame.
+     *
+     * @return pointer The 16-bit frame.
+     */
+    pointer operator->() const;
+
+    /**
+     * @brief Advances to the next frame of the range and reads it.
+     *
+     * @return Iterator& This iterator.
+     */
+    Iterator &operator++();
+
+    /**
+     * @brief Advances to the next frame of the range and reads it.
+     *
+     * The current frame is copied first, so prefer the prefix increment in loops.
+     *
+     * @return Proxy The frame before the increment, for *it++.
+     */
+    Proxy operator++(int);
+
+    /**
+     * @brief Gets the index of the current frame in the recording.
+     *
+     * @return size_t The frame index.
+     */
+    [[nodiscard]] size_t index() const { return m_index; }
+
+    bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+    bool operator!=(const Iterator &other) const { return m_index != other.m_index; }
+
+  private:
+    friend class FrameRange;
+
+    /**
+     * @brief Constructs an iterator at a frame.
+     *
+     * @param range The range that owns the frame buffer; nullptr for the end iterator.
+     * @param index The frame index.
+     */
+    Iterator(FrameRange *range, size_t index);
+
+    FrameRange *m_range = nullptr;//*< Range being iterated, or nullptr past the end.
+    size_t m_index = 0;//*< Current frame index.
+  };
+
+  /**
+   * @brief Constructs a range over frames first, first + step, ... before last.
+   *
+   * @param grabber The grabber to read from; must outlive the range.
+   * @param first The first frame.
+   * @param last One past the last frame that may be visited.
+   * @param step The distance between two visited frames; at least 1.
+   */
+  FrameRange(const FrameGrabberBase &grabber, size_t first, size_t last, size_t step);
+
+  // Iterators point at the range, so it is neither copied nor moved; frames() returns it
+  // by guaranteed copy elision.
+  FrameRange(const FrameRange &) = delete;
+  FrameRange &operator=(const FrameRange &) = delete;
+  FrameRange(FrameRange &&) = delete;
+  FrameRange &operator=(FrameRange &&) = delete;
+  ~FrameRange() = default;
+
+  /**
+   * @brief Starts the iteration and reads the first frame.
+   *
+   * @return Iterator The first frame, or end() for an empty range.
+   */
+  Iterator begin();
+
+  /**
+   * @brief Gets the position past the last frame.
+   *
+   * @return Iterator The end iterator.
+   */
+  [[nodiscard]] Iterator end() const { return Iterator(nullptr, m_end); }
+
+  /**
+   * @brief Gets the number of frames the range visits.
+   *
+   * @return size_t The number of frames.
+   */
+  [[nodiscard]] size_t size() const { return (m_end - m_first) / m_step; }
+
+  /**
+   * @brief Checks whether the range visits no frame.
+   *
+   * @return true if the range is empty.
+   */
+  [[nodiscard]] bool empty() const { return m_end == m_first; }
+
+private:
+  /**
+   * @brief Reads a frame into the buffer of the range.
+   *
+   * @param index The frame index.
+   */
+  void read(size_t index);
+
+  const FrameGrabberBase *m_grabber = nullptr;//*< Grabber the frames are read from.
+  size_t m_first = 0;//*< First visited frame.
+  size_t m_end = 0;//*< First frame past the range, on the step grid.
+  size_t m_step = 1;//*< Distance between visited frames.
+  cv::Mat m_frame;//*< Buffer reused for every frame.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_FRAME_RANGE_HPP */
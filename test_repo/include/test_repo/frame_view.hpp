@@ -0,0 +1,264 @@
+#ifndef NETXTEN_TYPES_FRAME_VIEW_HPP
+#define NETXTEN_TYPES_FRAME_VIEW_HPP
+
+#include "frame.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <optional>
+#include <stdexcept>
+#include <test_repo/export_macros.hpp>
+
+namespace netxten::types {
+
+/**
+ * @brief Metadata carried along with a frame.
+ */
+struct FrameMetadata
+{
+  uint64_t index = 0;///< Frame index in the recording, or frame counter of a live camera.
+  std::optional<int64_t> pts;///< Presentation timestamp in stream time base units, if known.
+  std::optional<double> time;///< Presentation time in seconds from the first frame, if known.
+};
+
+/**
+ * @brief Immutable, reference-counted handle to the pixels of a frame.
+ *
+ * Copying a view copies the handle, not the pixels: all copies share one buffer, which is
+ * released with the last of them. The pixels can be looked at as a cv::Mat, as an
+ * Eigen::Map of the Frame aliases or through raw row pointers, none of which copies. The
+ * buffer must not be written through any of these, since other views may share it.
+ */
+class SAMPLE_LIBRARY_API FrameView
+{
+public:
+  /**
+   * @brief Eigen view of the pixels with the element type of a Frame alias.
+   *
+   * Frame<T> is column-major while the pixels are stored row by row, so the map addresses
+   * them with an inner stride of one row and an outer stride of one element.
+   */
+  template<typename T>
+  using FrameMap = Eigen::Map<const Frame<T>, Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+  /**
+   * @brief Row-major Eigen view of the pixels in their stored layout.
+   */
+  template<typename T> using RowMajorMap = Eigen::Map<const RowMajorFrame<T>, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+  /**
+   * @brief Row-major Eigen view that lets Eigen use aligned SIMD loads.
+   */
+  template<typename T> using AlignedMap = Eigen::Map<const RowMajorFrame<T>, Eigen::Aligned16, Eigen::OuterStride<>>;
+
+  static constexpr size_t ALIGNMENT = 16;//*< Alignment of the first pixel and the rows of aligned views, in bytes.
+
+  /**
+   * @brief Constructs an empty view.
+   */
+  FrameView() = default;
+
+  /**
+   * @brief Constructs a view sharing the buffer of a cv::Mat.
+   *
+   * @param mat The image; its buffer is kept alive by the view, not copied.
+   * @param metadata The frame metadata.
+   */
+  explicit FrameView(cv::Mat mat, FrameMetadata metadata = {});
+
+  /**
+   * @brief Constructs a view of a buffer kept alive by an owner.
+   *
+   * @param owner Keeps the pixels alive for as long as any view refers to them.
+   * @param data The first pixel.
+   * @param rows The frame height.
+   * @param cols The frame width.
+   * @param step The distance between the starts of two rows, in bytes.
+   * @param type The OpenCV element type, e.g. CV_16U.
+   * @param metadata The frame metadata.
+   * @throws std::invalid_argument if the step is smaller than a row.
+   */
+  FrameView(std::shared_ptr<const void> owner,
+    const void *data,
+    int rows,
+    int cols,
+    size_t step,
+    int type,
+    FrameMetadata metadata = {});
+
+  /**
+   * @brief Checks whether the view has no pixels.
+   *
+   * @return true if the view is empty.
+   */
+  [[nodiscard]] bool empty() const { return m_data == nullptr || m_rows == 0 || m_cols == 0; }
+
+  /**
+   * @brief Gets the frame height.
+   *
+   * @return int The number of rows.
+   */
+  [[nodiscard]] int rows() const { return m_rows; }
+
+  /**
+   * @brief Gets the frame width.
+   *
+   * @return int The number of columns.
+   */
+  [[nodiscard]] int cols() const { return m_cols; }
+
+  /**
+   * @brief Gets the frame size.
+   *
+   * @return FrameSize The height and width.
+   */
+  [[nodiscard]] FrameSize size() const
+  {
+    return FrameSize{ static_cast<std::size_t>(m_rows), static_cast<std::size_t>(m_cols) };
+  }
+
+  /**
+   * @brief Gets the distance between the starts of two rows.
+   *
+   * @return size_t The row stride in bytes.
+   */
+  [[nodiscard]] size_t step() const { return m_step; }
+
+  /**
+   * @brief Gets the pixel type.
+   *
+   * @return int The OpenCV element type, e.g. CV_16U.
+   */
+  [[nodiscard]] int type() const { return m_type; }
+
+  /**
+   * @brief Gets the frame metadata.
+   *
+   * @return const FrameMetadata& The metadata.
+   */
+  [[nodiscard]] const FrameMetadata &metadata() const { return m_metadata; }
+
+  /**
+   * @brief Gets the first pixel.
+   *
+   * @return const uint8_t* The start of the first row, or nullptr for an empty view.
+   */
+  [[nodiscard]] const uint8_t *data() const { return m_data; }
+
+  /**
+   * @brief Gets the start of a row.
+   *
+   * @tparam T The pixel type; must match type().
+   * @param row The row index.
+   * @return const T* The first pixel of the row; cols() pixels follow it contiguously.
+   * @throws std::invalid_argument if T does not match the pixel type.
+   */
+  template<typename T> [[nodiscard]] const T *row(int row) const
+  {
+    checkType<T>();
+    return reinterpret_cast<const T *>(m_data + static_cast<size_t>(row) * m_step);
+  }
+
+  /**
+   * @brief Checks whether the first pixel and every row start on an ALIGNMENT boundary.
+   *
+   * @return true if alignedMap() can be used.
+   */
+  [[nodiscard]] bool isAligned() const;
+
+  /**
+   * @brief Checks whether the rows follow each other without padding.
+   *
+   * @return true if the pixels form one contiguous block.
+   */
+  [[nodiscard]] bool isContinuous() const;
+
+  /**
+   * @brief Views the pixels as a cv::Mat.
+   *
+   * For a view made from a cv::Mat, the header shares that image's reference count and
+   * keeps the buffer alive on its own; otherwise it is valid while the view is alive.
+   *
+   * @return cv::Mat The image; must not be written to.
+   */
+  [[nodiscard]] cv::Mat mat() const;
+
+  /**
+   * @brief Views the pixels as an Eigen matrix with the element type of a Frame alias.
+   *
+   * @tparam T The pixel type; must match type(), e.g. uint16_t for Frame16.
+   * @return FrameMap<T> The map, valid while the view is alive.
+   * @throws std::invalid_argument if T does not match the pixel type.
+   */
+  template<typename T> [[nodiscard]] FrameMap<T> map() const
+  {
+    checkType<T>();
+    const auto row_stride = static_cast<Eigen::Index>(m_step / sizeof(T));
+    return FrameMap<T>(reinterpret_cast<const T *>(m_data),
+      m_rows,
+      m_cols,
+      Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(1, row_stride));
+  }
+
+  /**
+   * @brief Views the pixels as a row-major Eigen matrix, in place and without a transpose.
+   *
+   * @tparam T The pixel type; must match type().
+   * @return RowMajorMap<T> The map, valid while the view is alive.
+   * @throws std::invalid_argument if T does not match the pixel type.
+   */
+  template<typename T> [[nodiscard]] RowMajorMap<T> rowMajorMap() const
+  {
+    checkType<T>();
+    return RowMajorMap<T>(reinterpret_cast<const T *>(m_data),
+      m_rows,
+      m_cols,
+      Eigen::OuterStride<>(static_cast<Eigen::Index>(m_step / sizeof(T))));
+  }
+
+  /**
+   * @brief Views the pixels as a row-major Eigen matrix that is known to be aligned.
+   *
+   * Per-pixel Eigen expressions on the map are vectorized with aligned loads.
+   *
+   * @tparam T The pixel type; must match type().
+   * @return AlignedMap<T> The map, valid while the view is alive.
+   * @throws std::invalid_argument if T does not match the pixel type.
+   * @throws std::logic_error if the view is not aligned.
+   */
+  template<typename T> [[nodiscard]] AlignedMap<T> alignedMap() const
+  {
+    checkType<T>();
+    if (!isAligned()) { throw std::logic_error("Frame buffer is not aligned"); }
+    return AlignedMap<T>(reinterpret_cast<const T *>(m_data),
+      m_rows,
+      m_cols,
+      Eigen::OuterStride<>(static_cast<Eigen::Index>(m_step / sizeof(T))));
+  }
+
+private:
+  /**
+   * @brief Checks that a C++ pixel type matches the OpenCV element type of the view.
+   *
+   * @tparam T The C++ pixel type.
+   * @throws std::invalid_argument on a mismatch.
+   */
+  template<typename T> void checkType() const
+  {
+    if (cv::DataType<T>::type != m_type) { throw std::invalid_argument("Pixel type does not match the frame"); }
+  }
+
+  cv::Mat m_mat;//*< Image the view was made from, if any.
+  std::shared_ptr<const void> m_owner;//*< Keeps the pixels alive if they do not belong to m_mat.
+  const uint8_t *m_data = nullptr;//*< First pixel.
+  int m_rows = 0;//*< Frame height.
+  int m_cols = 0;//*< Frame width.
+  size_t m_step = 0;//*< Row stride in bytes.
+  int m_type = 0;//*< OpenCV element type.
+  FrameMetadata m_metadata;//*< Frame metadata.
+};
+
+}// namespace netxten::types
+
+#endif /* NETXTEN_TYPES_FRAME_VIEW_HPP */
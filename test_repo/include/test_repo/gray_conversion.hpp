@@ -0,0 +1,73 @@
+#ifndef NETXTEN_UTILS_GRAY_CONVERSION_HPP
+#define NETXTEN_UTILS_GRAY_CONVERSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <test_repo/export_macros.hpp>
+
+namespace netxten::utils {
+
+/**
+ * @brief Instruction set used by the conversion kernels.
+ */
+enum class SimdLevel {
+  SCALAR,///< Portable C++.
+  SSE41,///< SSE4.1, 4 pixels per instruction.
+  AVX2,///< AVX2, 8 pixels per instruction.
+  AVX512///< AVX-512BW, 16 pixels per instruction.
+};
+
+/**
+ * @brief Detects the best instruction set the CPU supports; the result is cached.
+ *
+ * @return SimdLevel The level used by default.
+ */
+SAMPLE_LIBRARY_API SimdLevel detectSimdLevel();
+
+/**
+ * @brief Converts a BGR24 image to scaled 16-bit gray in a single pass.
+ *
+ * Computes ((1868 * b + 9617 * g + 4899 * r + 8192) >> 14) * scale per pixel, which
+ * is bit-exact with cv::cvtColor(COLOR_BGR2GRAY) followed by convertTo(CV_16U, scale),
+ * without the intermediate 8-bit image.
+ *
+ * @param bgr The first pixel of the source.
+ * @param bgr_step The distance between two source rows, in bytes.
+ * @param gray The first pixel of the destination.
+ * @param gray_step The distance between two destination rows, in bytes.
+ * @param rows The image height.
+ * @param cols The image width.
+ * @param scale The factor applied to the 8-bit gray value; at most 257.
+ */
+SAMPLE_LIBRARY_API void bgrToGray16(const uint8_t *bgr,
+  size_t bgr_step,
+  uint16_t *gray,
+  size_t gray_step,
+  int rows,
+  int cols,
+  uint16_t scale);
+
+/**
+ * @brief Converts a BGR24 image to scaled 16-bit gray with a given instruction set.
+ *
+ * @param bgr The first pixel of the source.
+ * @param bgr_step The distance between two source rows, in bytes.
+ * @param gray The first pixel of the destination.
+ * @param gray_step The distance between two destination rows, in bytes.
+ * @param rows The image height.
+ * @param cols The image width.
+ * @param scale The factor applied to the 8-bit gray value; at most 257.
+ * @param level The instruction set; lowered to detectSimdLevel() if the CPU lacks it.
+ */
+SAMPLE_LIBRARY_API void bgrToGray16(const uint8_t *bgr,
+  size_t bgr_step,
+  uint16_t *gray,
+  size_t gray_step,
+  int rows,
+  int cols,
+  uint16_t scale,
+  SimdLevel level);
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_GRAY_CONVERSION_HPP */
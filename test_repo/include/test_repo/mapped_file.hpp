@@ -0,0 +1,105 @@
+#ifndef NETXTEN_UTILS_MAPPED_FILE_HPP
+#define NETXTEN_UTILS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <test_repo/export_macros.hpp>
+
+namespace netxten::utils {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The file contents are accessible through data() for the lifetime of the object. An
+ * empty file is mapped as a null pointer with size zero.
+ */
+class SAMPLE_LIBRARY_API MappedFile
+{
+public:
+  /**
+   * @brief Expected access pattern, passed to the kernel to tune paging.
+   */
+  enum class AccessHint {
+    NORMAL,///< No particular pattern; the default read-ahead.
+    SEQUENTIAL,///< Pages are read in ascending order; read ahead aggressively.
+    RANDOM,///< Pages are read in no particular order; do not read ahead.
+    WILL_NEED///< The pages will be read soon; start reading them in now.
+  };
+
+  /**
+   * @brief Maps the given file into memory.
+   *
+   * @param path The path to the file.
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string &path);
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~MappedFile();
+
+  // Delete copy and move operations.
+  MappedFile(const MappedFile &) = delete;//*< Deleted copy constructor.
+  MappedFile &operator=(const MappedFile &) = delete;//*< Deleted copy assignment operator.
+  MappedFile(MappedFile &&) = delete;//*< Deleted move constructor.
+  MappedFile &operator=(MappedFile &&) = delete;//*< Deleted move assignment operator.
+
+  /**
+   * @brief Gets a pointer to the mapped file contents.
+   *
+   * @return const uint8_t* The first byte of the file, or nullptr for an empty file.
+   */
+  [[nodiscard]] const uint8_t *data() const { return m_data; }
+
+  /**
+   * @brief Gets the size of the mapping.
+   *
+   * @return size_t The file size in bytes.
+   */
+  [[nodiscard]] size_t size() const { return m_size; }
+
+  /**
+   * @brief Advises the kernel how the whole mapping will be accessed.
+   *
+   * @param hint The access pattern.
+   * @return true if the hint was passed on; false if it failed or is not supported here.
+   */
+  bool advise(AccessHint hint) const;
+
+  /**
+   * @brief Advises the kernel how part of the mapping will be accessed.
+   *
+   * The range is widened to whole pages and clipped to the mapping. Hints are only
+   * applied on POSIX systems.
+   *
+   * @param hint The access pattern.
+   * @param offset The first byte of the range.
+   * @param length The number of bytes in the range.
+   * @return true if the hint was passed on; false if it failed or is not supported here.
+   */
+  bool advise(AccessHint hint, size_t offset, size_t length) const;
+
+  /**
+   * @brief Gets the path of the mapped file.
+   *
+   * @return const std::string& The file path.
+   */
+  [[nodiscard]] const std::string &path() const { return m_path; }
+
+private:
+  std::string m_path;//*< Path of the mapped file.
+  const uint8_t *m_data = nullptr;//*< Start of the mapping.
+  size_t m_size = 0;//*< Size of the mapping in bytes.
+#ifdef _WIN32
+  void *m_file_handle = nullptr;//*< Windows file handle.
+  void *m_mapping_handle = nullptr;//*< Windows file mapping handle.
+#else
+  int m_fd = -1;//*< POSIX file descriptor.
+#endif
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_MAPPED_FILE_HPP */
@@ -0,0 +1,147 @@
+#ifndef NETXTEN_UTILS_RAW_GRABBER_HPP
+#define NETXTEN_UTILS_RAW_GRABBER_HPP
+
+#include "frame_grabber_base.hpp"
+#include "mapped_file.hpp"
+#include <atomic>
+#include <memory>
+#include <test_repo/export_macros.hpp>
+
+namespace netxten::utils {
+
+/**
+ * @brief Frame grabber for raw 16-bit frame sequences, read through a memory mapping.
+ *
+ * The file is a fixed-size header followed by frames of rows times columns native-endian
+ * 16-bit values, each optionally preceded by a fixed-size frame header. Opening the file
+ * only maps it, and a frame is located by arithmetic, so any frame is reached in constant
+ * time. getFrameView() hands out views of the mapping itself; the views keep the mapping
+ * alive after the grabber is destroyed.
+ */
+class SAMPLE_LIBRARY_API RawGrabber : public FrameGrabberBase
+{
+public:
+  /**
+   * @brief Layout of a raw frame file.
+   */
+  struct Layout
+  {
+    int rows = 0;///< Frame height.
+    int cols = 0;///< Frame width.
+    size_t header_bytes = 0;///< Size of the file header before the first frame; must be even.
+    size_t frame_header_bytes = 0;///< Size of the header before each frame; must be even.
+  };
+
+  static constexpr size_t READ_AHEAD_FRAMES = 4;//*< Frames paged in ahead of a sequential scan.
+
+  /**
+   * @brief Constructs a RawGrabber for the given file.
+   *
+   * @param file_path The path to the raw file.
+   * @param layout The layout of the file.
+   * @throws std::invalid_argument if the frame size is not positive or a header size is odd.
+   */
+  RawGrabber(const std::string &file_path, const Layout &layout);
+
+  [[nodiscard]] size_t getNumberOfFrames() const override;
+
+  /**
+   * @brief Retrieves a copy of a frame as a vector of pixels.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return std::vector<uint16_t> The 16-bit pixels in row-major order.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  [[nodiscard]] std::vector<uint16_t> getFrame(size_t index) const override;
+  [[nodiscard]] std::pair<int, int> getFrameSize() const override;
+
+  /**
+   * @brief Retrieves a copy of a frame as a cv::Mat.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return cv::Mat The 16-bit frame, which owns its data.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  [[nodiscard]] cv::Mat getCvFrame(size_t index) const override;
+
+  /**
+   * @brief Retrieves a frame as a view of the mapped file, without copying it.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return netxten::types::FrameView The frame.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  [[nodiscard]] netxten::types::FrameView getFrameView(size_t index) const override;
+
+  using FrameGrabberBase::getFrameInto;
+
+  /**
+   * @brief Copies a frame out of the mapping into a caller-provided cv::Mat.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the 16-bit frame; (re)allocated only if its size or type differ.
+   * @return true if the frame was retrieved.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  bool getFrameInto(size_t index, cv::Mat &frame) const override;
+
+protected:
+  /**
+   * @brief Maps the file and counts its frames.
+   *
+   * @throws std::runtime_error if the file cannot be mapped or is shorter than its header.
+   */
+  void setup() override;
+
+  /**
+   * @brief Advises the kernel of a sequential scan, or of random access for strided ranges.
+   *
+   * @param first The first frame the range reads.
+   * @param step The distance between two frames the range reads.
+   */
+  void beginSequential(size_t first, size_t step) const override;
+
+  /**
+   * @brief Copies a frame of a range and pages in the frames that follow it.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the 16-bit frame.
+   * @return true if the frame was retrieved.
+   */
+  bool readSequential(size_t index, cv::Mat &frame) const override;
+
+private:
+  /**
+   * @brief Checks that a frame index is in range.
+   *
+   * @param index The frame index.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  void check_index(size_t index) const;
+
+  /**
+   * @brief Gets a header over a frame of the mapping.
+   *
+   * @param index The frame index; must be in range.
+   * @return cv::Mat The frame; must not be written to.
+   */
+  [[nodiscard]] cv::Mat frame_header(size_t index) const;
+
+  /**
+   * @brief Gets the offset of a frame's pixels in the file.
+   *
+   * @param index The frame index.
+   * @return size_t The offset in bytes.
+   */
+  [[nodiscard]] size_t frame_offset(size_t index) const;
+
+  Layout m_layout;//*< Layout of the file.
+  size_t m_frame_bytes = 0;//*< Size of the pixels of one frame.
+  size_t m_total_frames = 0;//*< Number of complete frames in the file.
+  std::shared_ptr<MappedFile> m_mapping;//*< Mapping of the file, shared with the frame views.
+  mutable std::atomic<size_t> m_read_ahead_step{ 1 };//*< Step of the range being read, for read-ahead hints.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_RAW_GRABBER_HPP */
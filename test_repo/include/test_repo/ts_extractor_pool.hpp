@@ -0,0 +1,144 @@
+#ifndef NETXTEN_UTILS_TS_EXTRACTOR_POOL_HPP
+#define NETXTEN_UTILS_TS_EXTRACTOR_POOL_HPP
+
+#include "frame.hpp"
+#include "ts_frame_extractor.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <test_repo/export_macros.hpp>
+#include <vector>
+
+namespace netxten::utils {
+
+/**
+ * @brief Thread-safe frame access to one video through a pool of decoder contexts.
+ *
+ * Each context is an extractor cloned from the source, with its own demuxer and decoder,
+ * and all of them share the source's immutable index. Concurrent getFrame() calls are
+ * served by different contexts; a call prefers the idle context that last decoded the
+ * frame before it, so sequential readers keep their decoder state. Contexts are opened
+ * on demand up to the pool size; further callers wait for one to become idle.
+ */
+class SAMPLE_LIBRARY_API TSExtractorPool
+{
+public:
+  /**
+   * @brief Counters of the pool.
+   */
+  struct Stats
+  {
+    size_t contexts = 0;///< Contexts opened so far.
+    size_t requests = 0;///< Frames requested.
+    size_t sequential = 0;///< Requests served by the context that decoded the previous frame.
+    size_t waits = 0;///< Requests that had to wait for an idle context.
+  };
+
+  /**
+   * @brief Creates a pool with default decode options.
+   *
+   * @param source An extractor of the file; its index is shared by the pool.
+   * @param size Maximum number of contexts; 0 uses one per hardware thread.
+   * @throws std::runtime_error if the file cannot be opened.
+   */
+  TSExtractorPool(const TSFrameExtractor &source, size_t size);
+
+  /**
+   * @brief Creates a pool.
+   *
+   * @param source An extractor of the file; its index is shared by the pool.
+   * @param size Maximum number of contexts; 0 uses one per hardware thread.
+   * @param options The decode options of the contexts; the index options are ignored.
+   * @throws std::runtime_error if the file cannot be opened.
+   */
+  TSExtractorPool(const TSFrameExtractor &source, size_t size, const TSFrameExtractor::Options &options);
+
+  /**
+   * @brief Destructor.
+   */
+  ~TSExtractorPool();
+
+  // Delete copy and move operations.
+  TSExtractorPool(const TSExtractorPool &) = delete;//*< Deleted copy constructor.
+  TSExtractorPool &operator=(const TSExtractorPool &) = delete;//*< Deleted copy assignment operator.
+  TSExtractorPool(TSExtractorPool &&) = delete;//*< Deleted move constructor.
+  TSExtractorPool &operator=(TSExtractorPool &&) = delete;//*< Deleted move assignment operator.
+
+  /**
+   * @brief Retrieves a frame; may be called from several threads at once.
+   *
+   * @param frame_number The zero-based index of the desired frame.
+   * @return The frame data, or std::nullopt on failure.
+   * @throws std::out_of_range if the frame number is out of range.
+   */
+  std::optional<std::vector<uint8_t>> getFrame(size_t frame_number);
+
+  /**
+   * @brief Returns a buffer obtained from getFrame() so it can be reused for later frames.
+   *
+   * @param buffer The frame buffer to recycle. It is left empty.
+   */
+  void recycleFrame(std::vector<uint8_t> &&buffer);
+
+  /**
+   * @brief Gets the total number of frames in the video.
+   *
+   * @return size_t The frame count.
+   */
+  [[nodiscard]] size_t getTotalFrames() const { return m_total_frames; }
+
+  /**
+   * @brief Gets the maximum number of contexts.
+   *
+   * @return size_t The pool size.
+   */
+  [[nodiscard]] size_t getSize() const { return m_size; }
+
+  /**
+   * @brief Gets the pool counters.
+   *
+   * @return Stats The current statistics.
+   */
+  [[nodiscard]] Stats getStats() const;
+
+private:
+  /**
+   * @brief A decoder context and the frame it decoded last.
+   */
+  struct Slot
+  {
+    std::unique_ptr<TSFrameExtractor> extractor;//*< The context; null while it is being opened.
+    std::optional<size_t> last_frame;//*< Frame decoded last, if any.
+    bool busy = false;//*< Flag indicating a caller is using the context.
+  };
+
+  /**
+   * @brief Reserves the best idle context for a frame, opening or waiting for one if needed.
+   *
+   * @param frame_number The frame to decode.
+   * @return size_t The index of the reserved slot.
+   */
+  size_t acquire(size_t frame_number);
+
+  /**
+   * @brief Makes a context available again.
+   *
+   * @param slot The slot index.
+   * @param frame_number The frame the context decoded last, if it decoded one.
+   */
+  void release(size_t slot, std::optional<size_t> frame_number);
+
+  TSFrameExtractor::Options m_options;//*< Decode options of the contexts.
+  size_t m_size = 0;//*< Maximum number of contexts.
+  size_t m_total_frames = 0;//*< Frame count of the file.
+  mutable std::mutex m_mutex;//*< Guards the slots and the statistics.
+  std::condition_variable m_cv;//*< Signalled when a context becomes idle.
+  std::vector<Slot> m_slots;//*< One slot per context, allocated up front so slots never move.
+  size_t m_opened = 0;//*< One past the last slot whose context has been opened or is being opened.
+  Stats m_stats;//*< Pool counters.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_TS_EXTRACTOR_POOL_HPP */
@@ -2,6 +2,10 @@
 #define NETXTEN_UTILS_TS_FRAME_EXTRACTOR_HPP
 
 #include "frame.hpp"
+#include "file_follower.hpp"
+#include "frame_cache.hpp"
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -20,6 +24,119 @@ namespace netxten::utils {
 class SAMPLE_LIBRARY_API TSFrameExtractor
 {
 public:
+  /**
+   * @brief Counters describing the work and heap allocations done by the decode loop.
+   *
+   * The allocation counters only account for objects owned by the extractor (packets,
+   * frames, scaler contexts and output buffers). Once decoding has reached a steady state
+   * and the caller returns buffers through recycleFrame(), they stop increasing.
+   */
+  struct DecodeStats
+  {
+    size_t frames_decoded = 0;///< Frames received from the decoder.
+    size_t frames_returned = 0;///< Frames handed out to the caller, including cache hits.
+    size_t packet_allocations = 0;///< AVPacket allocations.
+    size_t frame_allocations = 0;///< AVFrame allocations.
+    size_t scaler_allocations = 0;///< SwsContext (re)allocations.
+    size_t buffer_allocations = 0;///< Output buffers that could not be served from the pool.
+    size_t frames_cancelled = 0;///< Requests abandoned through their cancel flag.
+    size_t seeks = 0;///< Container seeks to a keyframe.
+    size_t byte_seeks = 0;///< Seeks done by byte offset rather than by timestamp.
+  };
+
+  /**
+   * @brief How a timestamp is resolved to a frame.
+   */
+  enum class TimestampMatch {
+    EXACT,///< Only the frame with exactly this timestamp.
+    NEAREST,///< The frame with the closest timestamp; ties resolve to the earlier frame.
+    AT_OR_BEFORE///< The last frame presented at or before the timestamp.
+  };
+
+  /**
+   * @brief Options controlling how frames are decoded and returned.
+   */
+  struct Options
+  {
+    /// Pixel format of the frames returned by getFrame(). Gray formats are copied
+    /// straight from the luma plane when the decoder already produces full-range luma.
+    netxten::types::PixelFormat output_format = netxten::types::PixelFormat::BGR24;
+
+    /// Number of decoder threads: 0 lets FFmpeg pick one per core, 1 disables threading.
+    int decoder_threads = 0;
+
+    /// Decode several frames in parallel. Adds up to decoder_threads frames of latency
+    /// after every seek, which matters less than throughput for sequential reads.
+    bool frame_threading = true;
+
+    /// Decode the slices of a frame in parallel, for codecs and streams that support it.
+    bool slice_threading = true;
+
+    /// Save the keyframe index to a sidecar file and reuse it on later opens. The sidecar
+    /// is ignored when the video's size or modification time no longer match. Off by
+    /// default, since the default sidecar path writes next to the recording.
+    bool index_cache = false;
+
+    /// Path of the index sidecar; empty means the video path with ".idx" appended.
+    std::string index_cache_path;
+
+    /// Return from the constructor right after probing the streams and build the keyframe
+    /// index on a background thread. Frames outside the indexed range are located with a
+    /// timestamp seek until indexing completes.
+    bool background_indexing = false;
+
+    /// Byte budget of the decoded frame cache; 0 disables it. When enabled, every frame
+    /// decoded on the way from a keyframe to a requested frame is kept, so stepping back
+    /// through a GOP is served without seeking again.
+    size_t frame_cache_bytes = 0;
+
+    /// Frame evicted when the cache is full. Dropping the frame farthest from the last
+    /// request keeps the neighbourhood of the playhead while scrubbing.
+    FrameCache::EvictionPolicy frame_cache_policy = FrameCache::EvictionPolicy::FARTHEST_FROM_LAST_ACCESS;
+
+    /// Byte budget for reverse playback; 0 disables it. When a request steps back by one
+    /// frame, the GOP is decoded once, forward, and its frames are handed out in reverse
+    /// order from a buffer of at most this size. Larger backward jumps are served by a seek.
+    size_t reverse_buffer_bytes = 0;
+
+    /// Size of the returned frames, for previews. A zero dimension is derived from the
+    /// other one and the aspect ratio; a zero size returns frames at their native size.
+    /// Frames are downscaled during the pixel format conversion.
+    netxten::types::FrameSize output_size{};
+
+    /// Let codecs that support it decode at 1/2, 1/4 or 1/8 resolution when output_size
+    /// is at most that large, which skips most of the decoding work for small previews.
+    bool decoder_lowres = true;
+
+    /// Demux the file from a read-only memory mapping through a custom I/O context
+    /// instead of FFmpeg's file protocol, so reads are served from the page cache without
+    /// a system call per buffer. If the file cannot be mapped, it is read through the file
+    /// protocol instead and a warning is logged.
+    bool memory_map = true;
+
+    /// Follow a file that is still being recorded. The indexer waits at the end of the
+    /// file instead of stopping, the index is extended on a background thread as packets
+    /// arrive, and getTotalFrames() counts the frames indexed so far. Decoding never waits:
+    /// it reads up to the current end of the file. Following ends when the file stops
+    /// growing for follow_options.idle_timeout or stopFollowing() is called.
+    /// Implies background indexing and disables memory mapping and the index cache.
+    bool follow = false;
+
+    /// How a followed file is watched for new data.
+    FileFollower::Options follow_options{};
+
+    /// Seek MPEG-TS files to the byte offset of the keyframe packet recorded in the index
+    /// instead of searching the file for its timestamp. Other containers, and keyframes
+    /// without a known offset, are always sought by timestamp.
+    bool byte_seek = true;
+
+    /// Estimated cost of a seek, in decoded frames. When a requested frame lies ahead of
+    /// the decoder, the frames in between are decoded unless seeking to the keyframe of the
+    /// requested frame and decoding from there is estimated to be cheaper. With frame
+    /// threading, the decoder threads that refill after a seek are added to this cost.
+    double seek_cost_frames = 8.0;
+  };
+
   /**
    * @brief Constructs a TSFrameExtractor for the specified video file.
    *
@@ -28,15 +145,64 @@ public:
    */
   explicit TSFrameExtractor(const std::string &filename);
 
+  /**
+   * @brief Constructs a TSFrameExtractor for the specified video file with custom options.
+   *
+   * @param filename The path to the video file.
+   * @param options The decode options.
+   * @throws std::runtime_error if the file cannot be found or opened.
+   */
+  TSFrameExtractor(const std::string &filename, const Options &options);
+
+  /**
+   * @brief Constructs a TSFrameExtractor over a transport stream held in memory.
+   *
+   * The data is demuxed in place, without touching the filesystem. The index sidecar is
+   * not used for memory sources.
+   *
+   * @param data The video data; the caller keeps it alive and unchanged for the lifetime
+   * of the extractor and its clones.
+   * @param size The size of the video data in bytes.
+   * @throws std::invalid_argument if the buffer is empty.
+   * @throws std::runtime_error if the data cannot be demuxed.
+   */
+  TSFrameExtractor(const uint8_t *data, size_t size);
+
+  /**
+   * @brief Constructs a TSFrameExtractor over a transport stream held in memory with custom options.
+   *
+   * @param data The video data; the caller keeps it alive and unchanged for the lifetime
+   * of the extractor and its clones.
+   * @param size The size of the video data in bytes.
+   * @param options The decode options.
+   * @throws std::invalid_argument if the buffer is empty.
+   * @throws std::runtime_error if the data cannot be demuxed.
+   */
+  TSFrameExtractor(const uint8_t *data, size_t size, const Options &options);
+
   /**
    * @brief Destructor that cleans up resources.
    */
   ~TSFrameExtractor();
 
+  /**
+   * @brief Opens another extractor on the same file that shares this extractor's index.
+   *
+   * The new extractor has its own demuxer and decoder, so both can decode concurrently
+   * from different threads. Waits for background indexing to finish first, which for a
+   * followed file means until following ends.
+   *
+   * @param options The decode options of the new extractor; the index options are ignored.
+   * @return std::unique_ptr<TSFrameExtractor> The new extractor.
+   * @throws std::runtime_error if the file cannot be opened or indexing failed.
+   */
+  [[nodiscard]] std::unique_ptr<TSFrameExtractor> clone(const Options &options) const;
+
   /**
    * @brief Retrieves a specific frame by its frame number.
    *
-   * The frame is returned as a vector of bytes in BGR24 format.
+   * The frame is returned as a tightly packed vector of bytes in the output format
+   * selected in the options (BGR24 by default).
    *
    * @param frame_number The zero-based index of the desired frame.
    * @return An optional vector containing the frame data if successful, or std::nullopt
@@ -45,9 +211,180 @@ public:
    */
   std::optional<std::vector<uint8_t>> getFrame(size_t frame_number);
 
+  /**
+   * @brief Retrieves a frame, giving up as soon as a cancel flag is set.
+   *
+   * The flag is checked between decoded frames, so a request for a frame deep in a long
+   * GOP can be abandoned mid-GOP once it is no longer wanted, e.g. while scrubbing.
+   *
+   * @param frame_number The zero-based index of the desired frame.
+   * @param cancel Flag set by another thread to abandon the request.
+   * @return The frame data, or std::nullopt on failure or cancellation.
+   * @throws std::out_of_range if the frame number is out of range.
+   */
+  std::optional<std::vector<uint8_t>> getFrame(size_t frame_number, const std::atomic<bool> &cancel);
+
+  /**
+   * @brief Retrieves the frame with a presentation timestamp.
+   *
+   * The timestamp is resolved through the sorted timestamps of the index in O(log n), so
+   * gaps in the timestamps do not shift the result.
+   *
+   * @param pts The presentation timestamp in stream time base units.
+   * @param match How the timestamp is matched to a frame.
+   * @return The frame data, or std::nullopt if no frame matches or decoding failed.
+   */
+  std::optional<std::vector<uint8_t>> getFrameByPts(int64_t pts, TimestampMatch match = TimestampMatch::EXACT);
+
+  /**
+   * @brief Retrieves the frame shown at a time.
+   *
+   * @param seconds Time since the first frame in seconds.
+   * @param match How the time is matched to a frame. EXACT only matches times that round
+   * to the timestamp of a frame.
+   * @return The frame data, or std::nullopt if no frame matches or decoding failed.
+   */
+  std::optional<std::vector<uint8_t>> getFrameAtTime(double seconds, TimestampMatch match = TimestampMatch::NEAREST);
+
+  /**
+   * @brief Resolves a presentation timestamp to a frame number without decoding.
+   *
+   * Timestamps past the indexed part of the file are not resolved while indexing runs.
+   *
+   * @param pts The presentation timestamp in stream time base units.
+   * @param match How the timestamp is matched to a frame.
+   * @return The frame number, or std::nullopt if no frame matches.
+   */
+  [[nodiscard]] std::optional<size_t> findFrameByPts(int64_t pts, TimestampMatch match = TimestampMatch::EXACT) const;
+
+  /**
+   * @brief Resolves a time to a frame number without decoding.
+   *
+   * @param seconds Time since the first frame in seconds.
+   * @param match How the time is matched to a frame.
+   * @return The frame number, or std::nullopt if no frame matches.
+   */
+  [[nodiscard]] std::optional<size_t> findFrameAtTime(double seconds,
+    TimestampMatch match = TimestampMatch::NEAREST) const;
+
+  /**
+   * @brief Gets the presentation timestamp of a frame.
+   *
+   * @param frame_number The frame number.
+   * @return The timestamp in stream time base units, or std::nullopt if the frame is not indexed.
+   */
+  [[nodiscard]] std::optional<int64_t> getFramePts(size_t frame_number) const;
+
+  /**
+   * @brief Gets the time a frame is shown at.
+   *
+   * @param frame_number The frame number.
+   * @return Time since the first frame in seconds, or std::nullopt if the frame is not indexed.
+   */
+  [[nodiscard]] std::optional<double> getFrameTime(size_t frame_number) const;
+
+  /**
+   * @brief Callback receiving the frames of a batch request.
+   *
+   * Called with the frame number and the frame data in the output format. The buffer may
+   * be kept or handed back through recycleFrame().
+   */
+  using FrameCallback = std::function<void(size_t frame_number, std::vector<uint8_t> &&frame)>;
+
+  /**
+   * @brief Retrieves a set of frames, decoding each GOP at most once.
+   *
+   * The frame numbers are sorted and grouped by GOP: the extractor seeks once per GOP that
+   * contains requested frames and decodes forward through all of them.
+   *
+   * @param frame_numbers The frames to retrieve, in any order; duplicates are allowed.
+   * @return The frames in the order of frame_numbers; std::nullopt for frames that could
+   * not be decoded.
+   * @throws std::out_of_range if a frame number is out of range.
+   */
+  std::vector<std::optional<std::vector<uint8_t>>> getFrames(const std::vector<size_t> &frame_numbers);
+
+  /**
+   * @brief Streams a set of frames to a callback, decoding each GOP at most once.
+   *
+   * Frames are delivered in ascending frame order, once per distinct frame number, so only
+   * the frame being handed out is held in memory. Frames that cannot be decoded are skipped.
+   *
+   * @param frame_numbers The frames to retrieve, in any order.
+   * @param callback Receives each decoded frame.
+   * @throws std::out_of_range if a frame number is out of range.
+   */
+  void getFrames(const std::vector<size_t> &frame_numbers, const FrameCallback &callback);
+
+  /**
+   * @brief Streams every step-th frame of [first, last) to a callback.
+   *
+   * @param first The first frame.
+   * @param last One past the last frame.
+   * @param step The distance between frames; must be positive.
+   * @param callback Receives each decoded frame.
+   * @throws std::out_of_range if a frame number is out of range.
+   * @throws std::invalid_argument if step is zero.
+   */
+  void getFrames(size_t first, size_t last, size_t step, const FrameCallback &callback);
+
+  /**
+   * @brief Decodes the keyframes at or before the given frames, for timeline thumbnails.
+   *
+   * Only key packets are sent to a dedicated decoder that discards non-key frames, so
+   * each thumbnail costs one intra frame decode instead of a partial GOP. The images are
+   * scaled to the requested size while they are converted to the output format.
+   *
+   * @param frame_numbers The frames to represent, in any order. Frames in the same GOP
+   * share one thumbnail.
+   * @param size The thumbnail size; a zero dimension is derived from the aspect ratio and
+   * a zero size keeps the frame size.
+   * @param callback Receives the frame number of each keyframe and its image, in ascending
+   * order.
+   */
+  void getKeyframeThumbnails(const std::vector<size_t> &frame_numbers,
+    netxten::types::FrameSize size,
+    const FrameCallback &callback);
+
+  /**
+   * @brief Decodes a strip of keyframe thumbnails spread evenly over the video.
+   *
+   * @param count The number of sample points.
+   * @param size The thumbnail size, see getKeyframeThumbnails().
+   * @return The frame number and image of each distinct keyframe, in ascending order.
+   */
+  std::vector<std::pair<size_t, std::vector<uint8_t>>> getThumbnailStrip(size_t count, netxten::types::FrameSize size);
+
+  /**
+   * @brief Returns a buffer obtained from getFrame() so it can be reused for later frames.
+   *
+   * Recycling buffers lets the extractor write subsequent frames into already allocated
+   * memory instead of allocating a new output buffer for every frame.
+   *
+   * @param buffer The frame buffer to recycle. It is left empty.
+   */
+  void recycleFrame(std::vector<uint8_t> &&buffer);
+
+  /**
+   * @brief Gets the decode and allocation counters accumulated since construction.
+   *
+   * @return The current decode statistics.
+   */
+  [[nodiscard]] DecodeStats getDecodeStats() const;
+
+  /**
+   * @brief Gets the hit, miss and eviction counters of the decoded frame cache.
+   *
+   * @return The cache statistics; all zero if the cache is disabled.
+   */
+  [[nodiscard]] FrameCache::Stats getCacheStats() const;
+
   /**
    * @brief Gets the total number of frames in the video.
    *
+   * Once the index is complete this is the exact number of video packets; while it is
+   * still being built the count is estimated from the stream duration and frame rate.
+   *
    * @return The total frame count.
    */
   [[nodiscard]] size_t getTotalFrames() const;
@@ -76,10 +413,92 @@ public:
   /**
    * @brief Get the Frame Size object
    *
+   * This is the size of the returned frames, which differs from the video size when
+   * Options::output_size is set. It is known once the first frame has been decoded.
+   *
    * @return std::optional<netxten::types::FrameSize>
    */
   [[nodiscard]] std::optional<netxten::types::FrameSize> getFrameSize() const;
 
+  /**
+   * @brief Gets the fraction of the file that has been indexed.
+   *
+   * @return A value between 0 and 1; 1 once the index is complete.
+   */
+  [[nodiscard]] double getIndexingProgress() const;
+
+  /**
+   * @brief Checks whether the keyframe index covers the whole file.
+   *
+   * @return true if indexing has finished.
+   */
+  [[nodiscard]] bool isIndexComplete() const;
+
+  /**
+   * @brief Blocks until background indexing has finished or the timeout expires.
+   *
+   * @param timeout_seconds Maximum time to wait in seconds.
+   * @return true if the index is complete.
+   */
+  bool waitForIndex(double timeout_seconds = DEFAULT_TIMEOUT) const;
+
+  /**
+   * @brief Blocks until at least count frames can be retrieved.
+   *
+   * Meant for following a file that is being recorded: the call returns as soon as the
+   * indexer has read the frame, or when following ends or the timeout expires.
+   *
+   * @param count The frame count to wait for.
+   * @param timeout_seconds Maximum time to wait in seconds.
+   * @return true if getTotalFrames() is at least count.
+   */
+  bool waitForFrames(size_t count, double timeout_seconds = DEFAULT_TIMEOUT) const;
+
+  /**
+   * @brief Stops following the file, see Options::follow.
+   *
+   * Waiting reads return at once and the index is completed with the frames read so far.
+   */
+  void stopFollowing();
+
+  /**
+   * @brief Checks whether the file is still being followed.
+   *
+   * @return true while the file is followed; false once following ended or if it was not enabled.
+   */
+  [[nodiscard]] bool isFollowing() const;
+
+  /**
+   * @brief Gets the heap memory held by the frame index.
+   *
+   * The index stores 8 bytes per frame plus 32 bytes per keyframe, so a million frames
+   * with one keyframe per second at 30 fps take about 9 MB.
+   *
+   * @return The index size in bytes.
+   */
+  [[nodiscard]] size_t getIndexMemoryUsage() const;
+
+  /**
+   * @brief Checks whether the keyframe index was loaded from the sidecar file.
+   *
+   * @return true if the index came from the cache, false if the file was scanned.
+   */
+  [[nodiscard]] bool isIndexCached() const;
+
+  /**
+   * @brief Checks whether the file is demuxed from a memory mapping.
+   *
+   * @return true if the file was mapped, false if it is read through FFmpeg's file protocol.
+   */
+  [[nodiscard]] bool isMemoryMapped() const;
+
+  /**
+   * @brief Gets the pixel format of the frames returned by getFrame().
+   *
+   * @return netxten::types::PixelFormat
+   */
+  [[nodiscard]] netxten::types::PixelFormat getOutputFormat() const;
+
   // Delete copy and move operations.
   TSFrameExtractor(const TSFrameExtractor &) = delete;//*< Deleted copy constructor.
   TSFrameExtractor &operator=(const TSFrameExtractor &) = delete;//*< Deleted copy assignment operator.
@@ -88,14 +507,22 @@ public:
 
 private:
   static constexpr auto SEEK_RETRY_COUNT = 3;//*< Seek retry count.
-  static constexpr auto MIN_KEYFRAME_INTERVAL = 30;//*< Minimum keyframe interval.
   static constexpr auto DEFAULT_TIMEOUT = 5.0;//*< Default timeout in seconds.
+  static constexpr auto BUFFER_POOL_SIZE = 4;//*< Maximum number of recycled output buffers kept.
+  static constexpr auto INDEX_BATCH_SIZE = 512;//*< Packets indexed between publishing to readers.
 
   /**
    * @brief Private implementation class for TSFrameExtractor.
    */
   class TSFrameExtractorImpl;
 
+  /**
+   * @brief Constructs an extractor around an existing implementation, see clone().
+   *
+   * @param impl The implementation.
+   */
+  explicit TSFrameExtractor(std::unique_ptr<TSFrameExtractorImpl> impl);
+
   /**
    * @brief Pointer to the implementation (PIMPL idiom).
    */
@@ -0,0 +1,170 @@
+#ifndef NETXTEN_UTILS_TS_FRAME_INDEX_HPP
+#define NETXTEN_UTILS_TS_FRAME_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <test_repo/export_macros.hpp>
+#include <vector>
+
+namespace netxten::utils {
+
+/**
+ * @brief Flat, sorted frame index of a transport stream.
+ *
+ * Stores one presentation timestamp per frame in ascending order and a table of keyframe
+ * entries ordered by frame index. Lookups are binary searches over contiguous arrays,
+ * which costs 8 bytes per frame plus 32 bytes per keyframe instead of one heap node per
+ * packet. The index may be appended to while other threads read it.
+ */
+class SAMPLE_LIBRARY_API TSFrameIndex
+{
+public:
+  /**
+   * @brief A keyframe entry of the index.
+   */
+  struct Keyframe
+  {
+    uint64_t frame_index = 0;///< Frame index of the keyframe.
+    int64_t pts = 0;///< Presentation timestamp.
+    int64_t dts = 0;///< Decoding timestamp.
+    int64_t position = -1;///< Byte position of the packet in the file.
+  };
+
+  /**
+   * @brief Appends a batch of frames and keyframes found by the demuxer.
+   *
+   * Timestamps are inserted in sorted order; since packets arrive in decode order they
+   * only move past the few reordered frames before them. Keyframes must be appended in
+   * ascending frame index order.
+   *
+   * @param pts Presentation timestamps of the new frames.
+   * @param keyframes Keyframes among the new frames.
+   */
+  void append(const std::vector<int64_t> &pts, const std::vector<Keyframe> &keyframes);
+
+  /**
+   * @brief Removes all entries.
+   */
+  void clear();
+
+  /**
+   * @brief Releases the spare capacity left over from appending.
+   */
+  void shrinkToFit();
+
+  /**
+   * @brief Gets the exact number of indexed frames.
+   *
+   * @return size_t The frame count.
+   */
+  [[nodiscard]] size_t frameCount() const;
+
+  /**
+   * @brief Gets the number of indexed keyframes.
+   *
+   * @return size_t The keyframe count.
+   */
+  [[nodiscard]] size_t keyframeCount() const;
+
+  /**
+   * @brief Finds the last keyframe at or before a frame.
+   *
+   * @param frame_index The frame to look up.
+   * @return std::optional<Keyframe> The keyframe, or std::nullopt if there is none.
+   */
+  [[nodiscard]] std::optional<Keyframe> keyframeAtOrBefore(size_t frame_index) const;
+
+  /**
+   * @brief Checks whether a keyframe after the given frame has been indexed.
+   *
+   * @param frame_index The frame to look up.
+   * @return true if a later keyframe exists.
+   */
+  [[nodiscard]] bool hasKeyframeAfter(size_t frame_index) const;
+
+  /**
+   * @brief Finds the frame with exactly the given presentation timestamp.
+   *
+   * @param pts The presentation timestamp.
+   * @return std::optional<size_t> The frame index, or std::nullopt if no frame matches.
+   */
+  [[nodiscard]] std::optional<size_t> frameIndexForPts(int64_t pts) const;
+
+  /**
+   * @brief Finds the last frame presented at or before a timestamp.
+   *
+   * @param pts The presentation timestamp.
+   * @return std::optional<size_t> The frame index, or std::nullopt if every frame is later.
+   */
+  [[nodiscard]] std::optional<size_t> frameIndexAtOrBeforePts(int64_t pts) const;
+
+  /**
+   * @brief Finds the frame whose timestamp is closest to a timestamp.
+   *
+   * Ties between two frames resolve to the earlier one.
+   *
+   * @param pts The presentation timestamp.
+   * @return std::optional<size_t> The frame index, or std::nullopt if the index is empty.
+   */
+  [[nodiscard]] std::optional<size_t> nearestFrameIndexForPts(int64_t pts) const;
+
+  /**
+   * @brief Gets the presentation timestamp of a frame.
+   *
+   * @param frame_index The frame index.
+   * @return std::optional<int64_t> The timestamp, or std::nullopt if out of range.
+   */
+  [[nodiscard]] std::optional<int64_t> ptsForFrame(size_t frame_index) const;
+
+  /**
+   * @brief Gets the frame indices of all keyframes in ascending order.
+   *
+   * @return std::vector<int> The keyframe positions.
+   */
+  [[nodiscard]] std::vector<int> keyframePositions() const;
+
+  /**
+   * @brief Gets the heap memory held by the index.
+   *
+   * @return size_t The size in bytes.
+   */
+  [[nodiscard]] size_t memoryUsage() const;
+
+  /**
+   * @brief Loads the index from a memory-mapped sidecar file.
+   *
+   * The sidecar is only accepted if its format version matches and it was written for a
+   * video with the given size and modification time.
+   *
+   * @param path The sidecar path.
+   * @param source_size Size of the indexed video in bytes.
+   * @param source_mtime Modification time of the indexed video.
+   * @return true if the index was loaded.
+   */
+  bool load(const std::string &path, uint64_t source_size, int64_t source_mtime);
+
+  /**
+   * @brief Writes the index to a sidecar file.
+   *
+   * The file is written under a temporary name and renamed into place, so readers never
+   * map a partially written sidecar.
+   *
+   * @param path The sidecar path.
+   * @param source_size Size of the indexed video in bytes.
+   * @param source_mtime Modification time of the indexed video.
+   * @return true if the sidecar was written.
+   */
+  bool save(const std::string &path, uint64_t source_size, int64_t source_mtime) const;
+
+private:
+  mutable std::shared_mutex m_mutex;//*< Guards the arrays against concurrent appends.
+  std::vector<int64_t> m_pts;//*< Presentation timestamp of every frame, ascending.
+  std::vector<Keyframe> m_keyframes;//*< Keyframes ordered by frame index.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_TS_FRAME_INDEX_HPP */
@@ -3,14 +3,61 @@
 
 #include "frame.hpp"
 #include "frame_grabber_base.hpp"
+#include "ts_extractor_pool.hpp"
 #include "ts_frame_extractor.hpp"
+#include <future>
+#include <mutex>
+#include <optional>
 #include <test_repo/export_macros.hpp>
 
 namespace netxten::utils {
 class SAMPLE_LIBRARY_API TSGrabber : public FrameGrabberBase
 {
 public:
-  TSGrabber(const std::string &file_path, bool convert_to_16bit = true);
+  /**
+   * @brief Counters of the read-ahead prefetch worker.
+   */
+  struct PrefetchStats
+  {
+    size_t frames_prefetched = 0;///< Frames decoded ahead by the worker.
+    size_t hits = 0;///< Requests served from the prefetch queue.
+    size_t misses = 0;///< Requests decoded on demand on the calling thread.
+    size_t discarded = 0;///< Prefetched frames thrown away because access was not sequential.
+  };
+
+  /**
+   * @brief How asynchronous frame requests that arrive while one is decoding are handled.
+   */
+  enum class RequestPolicy {
+    QUEUE,///< Every request is decoded, in the order it was made.
+    LATEST_WINS///< A new request cancels all older ones, including the one being decoded.
+  };
+
+  /**
+   * @brief Counters of the asynchronous request worker.
+   */
+  struct RequestStats
+  {
+    size_t requests = 0;///< Frames requested through requestCvFrame().
+    size_t completed = 0;///< Requests decoded to the end; a failed decode resolves to an empty image.
+    size_t cancelled = 0;///< Requests superseded or cancelled before their frame was ready.
+  };
+
+  /**
+   * @brief Constructs a TSGrabber for the given transport stream file.
+   *
+   * @param file_path The path to the video file.
+   * @param convert_to_16bit Scale 8-bit gray values to the full 16-bit range.
+   * @param native_gray Let the extractor produce gray frames directly. This skips the BGR24
+   * conversion but takes the gray values from the decoder's luma, which can differ slightly
+   * from the default BGR24 to gray conversion.
+   */
+  TSGrabber(const std::string &file_path, bool convert_to_16bit = true, bool native_gray = false);
+
+  /**
+   * @brief Cancels outstanding frame requests and stops the worker threads.
+   */
+  ~TSGrabber() override;
 
   TSGrabber(const TSGrabber &) = delete;
   TSGrabber &operator=(const TSGrabber &) = delete;
@@ -23,18 +70,270 @@ public:
   [[nodiscard]] cv::Mat getCvFrame(size_t index) const override;
   [[nodiscard]] double getFrameRate() const override;
 
+  /**
+   * @brief Retrieves a frame as an immutable, reference-counted view.
+   *
+   * 16-bit frames decoded natively are handed out in the decode buffer itself; other
+   * formats are converted once into the buffer of the view. The view is always aligned,
+   * so FrameView::alignedMap() can be used. The metadata carries the presentation
+   * timestamp and time of the frame.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return netxten::types::FrameView The frame; empty if it could not be retrieved.
+   */
+  [[nodiscard]] netxten::types::FrameView getFrameView(size_t index) const override;
+
+  using FrameGrabberBase::getFrameInto;
+
+  /**
+   * @brief Retrieves a frame into a caller-provided cv::Mat.
+   *
+   * The decoded frame is converted to 16-bit gray straight into frame, without an
+   * intermediate image. With recycled decode buffers and a reused destination, no memory
+   * is allocated per frame.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the 16-bit frame; (re)allocated only if its size or type differ.
+   * @return true if the frame was retrieved.
+   */
+  bool getFrameInto(size_t index, cv::Mat &frame) const override;
+
+  /**
+   * @brief Retrieves several frames, decoding each GOP of the video at most once.
+   *
+   * @param indices The frames to retrieve, in any order; duplicates are allowed.
+   * @return std::vector<cv::Mat> The 16-bit frames in the order of indices.
+   */
+  [[nodiscard]] std::vector<cv::Mat> getCvFrames(const std::vector<size_t> &indices) const override;
+
+  /**
+   * @brief Streams several frames in ascending order, decoding each GOP at most once.
+   *
+   * Frames are decoded in batches of CALLBACK_BATCH_SIZE under the decoder lock, and the
+   * callback runs after the lock is released, so it may call back into the grabber.
+   *
+   * @param indices The frames to retrieve, in any order.
+   * @param callback Receives the index and the 16-bit frame.
+   * @throws std::out_of_range if an index is out of range; no frame is delivered then.
+   */
+  void getCvFrames(const std::vector<size_t> &indices,
+    const std::function<void(size_t, const cv::Mat &)> &callback) const override;
+
+  /**
+   * @brief Enables or disables the keyframe index sidecar at the default path.
+   *
+   * Must be called before initialize(). Disabled by default; when enabled, the sidecar is
+   * written next to the video as "<video>.idx".
+   *
+   * @param enabled Save the index on the first open and reuse it afterwards.
+   */
+  void setIndexCache(bool enabled);
+
+  /**
+   * @brief Enables or disables the keyframe index sidecar at a given path.
+   *
+   * Must be called before initialize().
+   *
+   * @param enabled Save the index on the first open and reuse it afterwards.
+   * @param path The sidecar path, e.g. in a cache directory; empty for "<video>.idx".
+   */
+  void setIndexCache(bool enabled, std::string path);
+
+  /**
+   * @brief Sets how many frames are decoded ahead on a worker thread; 0 disables prefetching.
+   *
+   * Prefetching starts once two consecutive frames are requested. While it runs, a worker
+   * decodes the following frames into a queue of at most depth frames, so decoding
+   * overlaps with the caller's processing. A non-sequential request drops the queue and
+   * is decoded on demand.
+   *
+   * @param depth Maximum number of frames decoded ahead.
+   * @throws std::runtime_error if the grabber is not initialized.
+   */
+  void setPrefetchDepth(size_t depth);
+
+  /**
+   * @brief Sets how many threads can decode frames at the same time.
+   *
+   * With more than one reader, getCvFrame() and getFrame() are served by a pool of decoder
+   * contexts that share the index, so calls from several threads decode in parallel
+   * instead of one after another. The prefetch worker is not used in that mode. Must not
+   * be called while frames are requested from other threads.
+   *
+   * @param readers Maximum number of concurrent decodes; 1 uses the single extractor and
+   * 0 one per hardware thread.
+   * @throws std::runtime_error if the grabber is not initialized or the file cannot be reopened.
+   */
+  void setReaderCount(size_t readers);
+
+  /**
+   * @brief Switches to reduced-resolution preview frames, or back to full size.
+   *
+   * Frames are downscaled inside the decoder's pixel format conversion, or decoded at a
+   * reduced resolution where the codec supports it, so no full-size frame is produced.
+   * getFrameSize() reports the preview size afterwards. Must not be called while frames
+   * are requested from other threads.
+   *
+   * @param size The preview size; a zero dimension keeps the aspect ratio and a zero size
+   * restores full-resolution frames.
+   * @throws std::runtime_error if the grabber is not initialized or the file cannot be reopened.
+   */
+  void setPreviewSize(netxten::types::FrameSize size);
+
+  /**
+   * @brief Requests a frame without blocking the caller.
+   *
+   * The frame is decoded on a worker thread. Under RequestPolicy::LATEST_WINS, which suits
+   * a timeline slider, a newer request cancels the older ones: their futures resolve to
+   * an empty image, and a decode already in progress is abandoned between two frames
+   * instead of running to the end of its GOP.
+   *
+   * @param index The index of the frame to retrieve.
+   * @return std::future<cv::Mat> The 16-bit frame; empty if the request was cancelled or
+   * decoding failed.
+   * @throws std::out_of_range if the index is out of range.
+   */
+  [[nodiscard]] std::future<cv::Mat> requestCvFrame(size_t index);
+
+  /**
+   * @brief Cancels all outstanding frame requests; their futures resolve to an empty image.
+   */
+  void cancelRequests();
+
+  /**
+   * @brief Sets how requests made through requestCvFrame() are coalesced.
+   *
+   * @param policy The request policy; RequestPolicy::QUEUE by default.
+   */
+  void setRequestPolicy(RequestPolicy policy);
+
+  /**
+   * @brief Gets the asynchronous request counters.
+   *
+   * @return RequestStats The statistics accumulated since the first request.
+   */
+  [[nodiscard]] RequestStats getRequestStats() const;
+
+  /**
+   * @brief Gets the prefetch counters.
+   *
+   * @return PrefetchStats The statistics accumulated since prefetching was enabled.
+   */
+  [[nodiscard]] PrefetchStats getPrefetchStats() const;
+
 protected:
   /**
    * @brief Initializes the video capture object and retrieves video properties.
    */
   void setup() override;
 
+  /**
+   * @brief Starts the read-ahead at the first frame of a consecutive range, if prefetching is enabled.
+   *
+   * @param first The first frame the range reads.
+   * @param step The distance between two frames the range reads.
+   */
+  void beginSequential(size_t first, size_t step) const override;
+
+  /**
+   * @brief Reads a frame of a range into the reused buffer, without the per-call checks.
+   *
+   * @param index The index of the frame to retrieve.
+   * @param frame Receives the 16-bit frame.
+   * @return true if the frame was retrieved.
+   */
+  bool readSequential(size_t index, cv::Mat &frame) const override;
+
 private:
+  static constexpr auto CALLBACK_BATCH_SIZE = 8;//*< Frames decoded per lock by the streaming getCvFrames().
+
+  /**
+   * @brief State shared with the prefetch worker thread.
+   */
+  struct Prefetcher;
+
+  /**
+   * @brief State shared with the asynchronous request worker thread.
+   */
+  struct Requester;
+
+  /**
+   * @brief Gets a frame in the extractor's output format, from the prefetch queue if possible.
+   *
+   * @param index The frame index.
+   * @return The raw frame data, or std::nullopt on failure.
+   */
+  std::optional<std::vector<uint8_t>> fetch_frame(size_t index) const;
+
+  /**
+   * @brief Converts a raw frame in the extractor's output format to a 16-bit gray image.
+   *
+   * @param frame The raw frame data.
+   * @return cv::Mat The converted image, which owns its data.
+   */
+  cv::Mat to_gray16(std::vector<uint8_t> &frame) const;
+
+  /**
+   * @brief Converts a raw frame in the extractor's output format into a 16-bit gray image.
+   *
+   * @param frame The raw frame data.
+   * @param image Receives the converted image; its memory is reused if the size matches.
+   */
+  void to_gray16(std::vector<uint8_t> &frame, cv::Mat &image) const;
+
+  /**
+   * @brief Builds the extractor options for the grabber's output settings.
+   *
+   * @return TSFrameExtractor::Options The options.
+   */
+  [[nodiscard]] TSFrameExtractor::Options extractor_options() const;
+
+  /**
+   * @brief Drops the prefetch queue before the extractor is used outside the worker.
+   */
+  void reset_prefetch() const;
+
+  /**
+   * @brief Hands a raw frame buffer back for reuse by the extractor.
+   *
+   * @param buffer The buffer to recycle.
+   */
+  void recycle_frame(std::vector<uint8_t> &&buffer) const;
+
+  /**
+   * @brief Prefetch worker thread body.
+   */
+  void prefetch_loop() const;
+
+  /**
+   * @brief Stops and joins the prefetch worker, if running.
+   */
+  void stop_prefetch();
+
+  /**
+   * @brief Asynchronous request worker thread body.
+   */
+  void request_loop();
+
+  /**
+   * @brief Cancels outstanding requests and joins the request worker, if running.
+   */
+  void stop_requests();
+
   bool m_convert_to_16bit = true;//*< Flag to convert frames to 16-bit grayscale.
+  bool m_native_gray = false;//*< Flag to decode straight to gray instead of BGR24.
   std::unique_ptr<class TSFrameExtractor> m_extractor;//*< Pointer to the frame extractor.
-  netxten::types::FrameSize m_frame_size;//*< Video frame size.
+  netxten::types::FrameSize m_frame_size;//*< Size of the returned frames.
+  netxten::types::FrameSize m_preview_size{};//*< Requested preview size; zero for full resolution.
+  bool m_index_cache = false;//*< Flag to persist the keyframe index in a sidecar file.
+  std::string m_index_cache_path;//*< Path of the index sidecar; empty for the default next to the video.
   size_t m_total_frames = 0;//*< Total number of frames.
   double m_frame_rate = -1;//*< Video frame rate.
+  mutable std::mutex m_extractor_mutex;//*< Serializes access to the extractor between the caller and the worker.
+  std::unique_ptr<Prefetcher> m_prefetcher;//*< Prefetch state, if prefetching is enabled.
+  std::unique_ptr<TSExtractorPool> m_pool;//*< Decoder contexts for concurrent readers, if enabled.
+  std::unique_ptr<Requester> m_requester;//*< Asynchronous request state, created by the first request.
+  RequestPolicy m_request_policy = RequestPolicy::QUEUE;//*< Coalescing policy of asynchronous requests.
 };
 }// namespace netxten::utils
 #endif /* NETXTEN_UTILS_TS_GRABBER_HPP */
\ No newline at end of file
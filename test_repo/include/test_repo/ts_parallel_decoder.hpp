@@ -0,0 +1,133 @@
+#ifndef NETXTEN_UTILS_TS_PARALLEL_DECODER_HPP
+#define NETXTEN_UTILS_TS_PARALLEL_DECODER_HPP
+
+#include "frame.hpp"
+#include "ts_frame_extractor.hpp"
+#include <memory>
+#include <test_repo/export_macros.hpp>
+#include <vector>
+
+namespace netxten::utils {
+
+/**
+ * @brief Decodes a range of a transport stream on several threads at once.
+ *
+ * The range is split at keyframes into segments that decode independently. Each worker
+ * thread owns an extractor cloned from the source, with its own demuxer and decoder, and
+ * picks up the next undecoded segment until all are done.
+ */
+class SAMPLE_LIBRARY_API TSParallelDecoder
+{
+public:
+  /**
+   * @brief How decoded frames are handed to the callback.
+   */
+  enum class Delivery {
+    ORDERED,///< In ascending frame order, from the thread calling run().
+    UNORDERED///< As soon as they are decoded, concurrently from the worker threads.
+  };
+
+  /**
+   * @brief Options of a parallel sweep.
+   */
+  struct Options
+  {
+    /// Number of worker threads; 0 uses one per hardware thread.
+    size_t workers = 0;
+
+    /// Delivery order of the frames.
+    Delivery delivery = Delivery::ORDERED;
+
+    /// Frames decoded ahead of the next frame to deliver in ordered mode. Workers pause
+    /// when the reorder buffer is full, which bounds memory use.
+    size_t reorder_capacity = 64;
+
+    /// Pixel format of the delivered frames.
+    netxten::types::PixelFormat output_format = netxten::types::PixelFormat::BGR24;
+  };
+
+  /**
+   * @brief Creates the worker extractors with default options.
+   *
+   * @param source An extractor of the file to decode; its index is shared by the workers.
+   * @throws std::runtime_error if the workers cannot open the file.
+   */
+  explicit TSParallelDecoder(const TSFrameExtractor &source);
+
+  /**
+   * @brief Creates the worker extractors.
+   *
+   * @param source An extractor of the file to decode; its index is shared by the workers.
+   * @param options The sweep options.
+   * @throws std::runtime_error if the workers cannot open the file.
+   */
+  TSParallelDecoder(const TSFrameExtractor &source, const Options &options);
+
+  /**
+   * @brief Destructor.
+   */
+  ~TSParallelDecoder();
+
+  // Delete copy and move operations.
+  TSParallelDecoder(const TSParallelDecoder &) = delete;//*< Deleted copy constructor.
+  TSParallelDecoder &operator=(const TSParallelDecoder &) = delete;//*< Deleted copy assignment operator.
+  TSParallelDecoder(TSParallelDecoder &&) = delete;//*< Deleted move constructor.
+  TSParallelDecoder &operator=(TSParallelDecoder &&) = delete;//*< Deleted move assignment operator.
+
+  /**
+   * @brief Decodes the frames [first, last) and hands each one to the callback.
+   *
+   * In unordered mode the callback is called from several threads at once and must be
+   * thread-safe. The first exception thrown by a worker or the callback stops the sweep
+   * and is rethrown.
+   *
+   * @param first The first frame.
+   * @param last One past the last frame; clamped to the frame count.
+   * @param callback Receives the frame number and the frame data.
+   * @return size_t The number of frames delivered.
+   */
+  size_t run(size_t first, size_t last, const TSFrameExtractor::FrameCallback &callback);
+
+  /**
+   * @brief Decodes the whole file and hands each frame to the callback.
+   *
+   * @param callback Receives the frame number and the frame data.
+   * @return size_t The number of frames delivered.
+   */
+  size_t run(const TSFrameExtractor::FrameCallback &callback);
+
+  /**
+   * @brief Gets the number of worker threads.
+   *
+   * @return size_t The worker count.
+   */
+  [[nodiscard]] size_t getWorkerCount() const { return m_workers.size(); }
+
+private:
+  /**
+   * @brief A range of frames starting at a keyframe.
+   */
+  struct Segment
+  {
+    size_t first = 0;//*< First frame of the segment.
+    size_t last = 0;//*< One past the last frame of the segment.
+  };
+
+  /**
+   * @brief Splits [first, last) at the keyframes of the index.
+   *
+   * @param first The first frame.
+   * @param last One past the last frame.
+   * @return std::vector<Segment> The segments in frame order.
+   */
+  std::vector<Segment> split(size_t first, size_t last) const;
+
+  Options m_options;//*< Sweep options.
+  std::vector<int> m_keyframes;//*< Keyframe positions of the file.
+  size_t m_total_frames = 0;//*< Frame count of the file.
+  std::vector<std::unique_ptr<TSFrameExtractor>> m_workers;//*< One extractor per worker thread.
+};
+
+}// namespace netxten::utils
+
+#endif /* NETXTEN_UTILS_TS_PARALLEL_DECODER_HPP */
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <test_repo/file_follower.hpp>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace netxten::utils;
+
+namespace {
+
+/**
+ * @brief Seeks with 64-bit offsets on every platform.
+ */
+int seekFile(std::FILE *file, int64_t offset, int whence)
+{
+#ifdef _WIN32
+  return _fseeki64(file, offset, whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
+}
+
+/**
+ * @brief Gets the position of a file with 64-bit offsets on every platform.
+ */
+int64_t tellFile(std::FILE *file)
+{
+#ifdef _WIN32
+  return _ftelli64(file);
+#else
+  return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+}// namespace
+
+FileFollower::FileFollower(const std::string &path, const Options &options, const std::atomic<bool> &stop)
+  : m_path(path), m_options(options), m_stop(stop)
+{
+  m_file = std::fopen(path.c_str(), "rb");
+  if (m_file == nullptr) {
+    spdlog::error("Failed to open file for following: {}", path);
+    throw std::runtime_error("Failed to open file for following: " + path);
+  }
+
+#ifdef __linux__
+  if (m_options.use_inotify) {
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd >= 0 && inotify_add_watch(m_inotify_fd, path.c_str(), IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+      close(m_inotify_fd);
+      m_inotify_fd = -1;
+    }
+    if (m_inotify_fd < 0) { spdlog::warn("inotify unavailable for {}, polling instead", path); }
+  }
+#endif
+}
+
+FileFollower::~FileFollower()
+{
+#ifdef __linux__
+  if (m_inotify_fd >= 0) { close(m_inotify_fd); }
+#endif
+  std::fclose(m_file);
+}
+
+int FileFollower::read(uint8_t *buffer, int size)
+{
+  if (size <= 0) { return 0; }
+  while (true) {
+    if (const int count = readAvailable(buffer, size); count > 0) { return count; }
+    if (!wait_for_data()) { return 0; }
+  }
+}
+
+int FileFollower::readAvailable(uint8_t *buffer, int size)
+{
+  if (size <= 0) { return 0; }
+  const size_t count = std::fread(buffer, 1, static_cast<size_t>(size), m_file);
+  m_position += static_cast<int64_t>(count);
+
+  // At the current end: forget the EOF state so the next fread() sees appended data.
+  if (count == 0) { std::clearerr(m_file); }
+  return static_cast<int>(count);
+}
+
+bool FileFollower::wait_for_data()
+{
+  const auto poll_interval = std::chrono::duration<double>(m_options.poll_interval);
+  const auto idle_since = std::chrono::steady_clock::now();
+  while (!m_stop) {
+    if (size() > m_position) { return true; }
+    if (m_options.idle_timeout > 0
+        && std::chrono::steady_clock::now() - idle_since >= std::chrono::duration<double>(m_options.idle_timeout)) {
+      spdlog::info("{} stopped growing at {} bytes", m_path, m_position);
+      return false;
+    }
+
+#ifdef __linux__
+    if (m_inotify_fd >= 0) {
+      // Sleep until the writer touches the file, but wake up regularly for the stop flag.
+      pollfd descriptor{ m_inotify_fd, POLLIN, 0 };
+      const auto timeout_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(poll_interval).count());
+      if (poll(&descriptor, 1, std::max(1, timeout_ms)) > 0) {
+        std::array<char, 4096> events{};
+        while (::read(m_inotify_fd, events.data(), events.size()) > 0) {}
+      }
+      continue;
+    }
+#endif
+    std::this_thread::sleep_for(poll_interval);
+  }
+  return false;
+}
+
+int64_t FileFollower::seek(int64_t offset, int whence)
+{
+  std::clearerr(m_file);
+  if (seekFile(m_file, offset, whence) != 0) { return -1; }
+  m_position = tellFile(m_file);
+  return m_position;
+}
+
+int64_t FileFollower::size() const
+{
+  // Ask the filesystem, so the buffered read position of the stream is left alone.
+  std::error_code error;
+  const auto file_size = std::filesystem::file_size(m_path, error);
+  return error ? -1 : static_cast<int64_t>(file_size);
+}
@@ -529,6 +529,16 @@ std::pair<uint64_t, std::optional<cv::Mat>> FlirCamera::getLatestFrame(uint64_t
   return { newFrame, m_previous_frame };
 }
 
+std::pair<uint64_t, std::optional<netxten::types::FrameView>> FlirCamera::getLatestFrameView(uint64_t lastSeenFrame)
+{
+  auto [frame_id, frame] = getLatestFrame(lastSeenFrame);
+  if (!frame.has_value() || frame->empty()) { return { frame_id, std::nullopt }; }
+
+  netxten::types::FrameMetadata metadata;
+  metadata.index = frame_id;
+  return { frame_id, netxten::types::FrameView(std::move(frame.value()), metadata) };
+}
+
 void FlirCamera::playStreamCV()
 {
 
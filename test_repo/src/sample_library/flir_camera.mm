@@ -817,6 +817,18 @@ FlirCamera::getLatestFrame(uint64_t lastSeenFrame) {
   return m_impl->getLatestFrame(lastSeenFrame);
 }
 
+std::pair<uint64_t, std::optional<netxten::types::FrameView>>
+FlirCamera::getLatestFrameView(uint64_t lastSeenFrame) {
+  auto [frame_id, frame] = m_impl->getLatestFrame(lastSeenFrame);
+  if (!frame.has_value() || frame->empty()) {
+    return {frame_id, std::nullopt};
+  }
+
+  netxten::types::FrameMetadata metadata;
+  metadata.index = frame_id;
+  return {frame_id, netxten::types::FrameView(std::move(frame.value()), metadata)};
+}
+
 std::optional<std::string> FlirCamera::getModelName() const {
   return m_impl->getModelName();
 }
@@ -0,0 +1,69 @@
+#include <test_repo/frame_buffer_pool.hpp>
+#include <test_repo/frame_grabber_base.hpp>
+
+using namespace netxten::utils;
+
+FrameBufferPool::Buffer::Buffer(FrameBufferPool *pool, cv::Mat mat) : m_pool(pool), m_mat(std::move(mat)) {}
+
+FrameBufferPool::Buffer::~Buffer()
+{
+  if (m_pool != nullptr) { m_pool->release(std::move(m_mat)); }
+}
+
+FrameBufferPool::Buffer::Buffer(Buffer &&other) noexcept : m_pool(other.m_pool), m_mat(std::move(other.m_mat))
+{
+  other.m_pool = nullptr;
+}
+
+FrameBufferPool::Buffer &FrameBufferPool::Buffer::operator=(Buffer &&other) noexcept
+{
+  if (this != &other) {
+    if (m_pool != nullptr) { m_pool->release(std::move(m_mat)); }
+    m_pool = other.m_pool;
+    m_mat = std::move(other.m_mat);
+    other.m_pool = nullptr;
+  }
+  return *this;
+}
+
+FrameBufferPool::FrameBufferPool(int rows, int cols, int type, size_t max_idle)
+  : m_rows(rows), m_cols(cols), m_type(type), m_max_idle(max_idle)
+{}
+
+FrameBufferPool::FrameBufferPool(const FrameGrabberBase &grabber, size_t max_idle)
+  : FrameBufferPool(grabber.getFrameSize().first, grabber.getFrameSize().second, CV_16U, max_idle)
+{}
+
+FrameBufferPool::Buffer FrameBufferPool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_idle.empty()) {
+      cv::Mat mat = std::move(m_idle.back());
+      m_idle.pop_back();
+      ++m_stats.reuses;
+      m_stats.idle = m_idle.size();
+      return Buffer(this, std::move(mat));
+    }
+    ++m_stats.allocations;
+  }
+  return Buffer(this, cv::Mat(m_rows, m_cols, m_type));
+}
+
+void FrameBufferPool::release(cv::Mat &&mat)
+{
+  // A buffer that was reallocated or is still shared with another cv::Mat is not reused.
+  if (mat.rows != m_rows || mat.cols != m_cols || mat.type() != m_type || mat.u == nullptr || mat.u->refcount != 1) {
+    mat.release();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_idle.size() < m_max_idle) { m_idle.push_back(std::move(mat)); }
+  m_stats.idle = m_idle.size();
+}
+
+FrameBufferPool::Stats FrameBufferPool::getStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
@@ -0,0 +1,79 @@
+#include <iterator>
+#include <test_repo/frame_cache.hpp>
+
+using namespace netxten::utils;
+
+FrameCache::FrameCache(size_t byte_budget, EvictionPolicy policy) : m_budget(byte_budget), m_policy(policy) {}
+
+const std::vector<uint8_t> *FrameCache::lookup(size_t frame_number)
+{
+  m_last_access = frame_number;
+  auto it = m_entries.find(frame_number);
+  if (it == m_entries.end()) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  ++m_stats.hits;
+  m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+  return &it->second.data;
+}
+
+bool FrameCache::contains(size_t frame_number) const { return m_entries.count(frame_number) != 0; }
+
+void FrameCache::insert(size_t frame_number, const uint8_t *data, size_t size)
+{
+  if (size > m_budget) { return; }
+
+  if (auto it = m_entries.find(frame_number); it != m_entries.end()) {
+    m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+    return;
+  }
+
+  while (!m_entries.empty() && m_stats.bytes + size > m_budget) { evict_one(); }
+
+  // Reuse the memory of an evicted frame when there is one.
+  Entry entry;
+  entry.data = std::move(m_spare);
+  m_spare = std::vector<uint8_t>{};
+  entry.data.assign(data, data + size);
+  m_recency.push_front(frame_number);
+  entry.recency = m_recency.begin();
+  m_entries.emplace(frame_number, std::move(entry));
+
+  m_stats.bytes += size;
+  ++m_stats.insertions;
+  m_stats.entries = m_entries.size();
+}
+
+void FrameCache::evict_one()
+{
+  auto victim = m_entries.end();
+  if (m_policy == EvictionPolicy::LEAST_RECENTLY_USED) {
+    victim = m_entries.find(m_recency.back());
+  } else {
+    // Entries are ordered by frame number, so the farthest one is at either end.
+    auto first = m_entries.begin();
+    auto last = std::prev(m_entries.end());
+    const size_t below = m_last_access > first->first ? m_last_access - first->first : 0;
+    const size_t above = last->first > m_last_access ? last->first - m_last_access : 0;
+    victim = above >= below ? last : first;
+  }
+
+  m_stats.bytes -= victim->second.data.size();
+  m_recency.erase(victim->second.recency);
+  m_spare = std::move(victim->second.data);
+  m_entries.erase(victim);
+  ++m_stats.evictions;
+  m_stats.entries = m_entries.size();
+}
+
+void FrameCache::clear()
+{
+  m_entries.clear();
+  m_recency.clear();
+  m_spare = std::vector<uint8_t>{};
+  m_stats = Stats{};
+}
+
+FrameCache::Stats FrameCache::getStats() const { return m_stats; }
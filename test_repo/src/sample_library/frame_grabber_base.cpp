@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <spdlog/spdlog.h>
 #include <test_repo/frame_grabber_base.hpp>
 
@@ -60,6 +61,89 @@ void FrameGrabberBase::checkInitialization() const
   throw std::runtime_error("Frame grabber is not initialized.");
 }
 
+netxten::types::FrameView FrameGrabberBase::getFrameView(size_t index) const
+{
+  cv::Mat image = getCvFrame(index);
+  if (image.empty()) { return netxten::types::FrameView{}; }
+
+  netxten::types::FrameMetadata metadata;
+  metadata.index = index;
+  if (const double frame_rate = getFrameRate(); frame_rate > 0) {
+    metadata.time = static_cast<double>(index) / frame_rate;
+  }
+  return netxten::types::FrameView(std::move(image), metadata);
+}
+
+bool FrameGrabberBase::getFrameInto(size_t index, cv::Mat &frame) const
+{
+  const cv::Mat image = getCvFrame(index);
+  if (image.empty()) { return false; }
+  image.copyTo(frame);
+  return true;
+}
+
+bool FrameGrabberBase::getFrameInto(size_t index, uint16_t *buffer, size_t size) const
+{
+  const auto [rows, cols] = getFrameSize();
+  if (buffer == nullptr || size < static_cast<size_t>(rows) * static_cast<size_t>(cols)) {
+    spdlog::warn("getFrameInto: buffer of {} values is too small for a {}x{} frame", size, cols, rows);
+    return false;
+  }
+
+  // A header over the caller's memory: the frame is written in place as long as the
+  // grabber produces 16-bit frames of the reported size.
+  cv::Mat frame(rows, cols, CV_16U, buffer);
+  if (!getFrameInto(index, frame)) { return false; }
+  if (frame.data != reinterpret_cast<uint8_t *>(buffer)) {
+    spdlog::warn("getFrameInto: frame {} does not match the reported size and type", index);
+    return false;
+  }
+  return true;
+}
+
+bool FrameGrabberBase::getFrameInto(size_t index, netxten::types::RowMajorFrame16 &frame) const
+{
+  const auto [rows, cols] = getFrameSize();
+  if (frame.rows() != rows || frame.cols() != cols) { frame.resize(rows, cols); }
+  return getFrameInto(index, frame.data(), static_cast<size_t>(frame.size()));
+}
+
+std::vector<cv::Mat> FrameGrabberBase::getCvFrames(const std::vector<size_t> &indices) const
+{
+  std::vector<cv::Mat> frames;
+  frames.reserve(indices.size());
+  for (const size_t index : indices) { frames.push_back(getCvFrame(index)); }
+  return frames;
+}
+
+void FrameGrabberBase::getCvFrames(const std::vector<size_t> &indices,
+  const std::function<void(size_t, const cv::Mat &)> &callback) const
+{
+  std::vector<size_t> sorted(indices);
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  for (const size_t index : sorted) { callback(index, getCvFrame(index)); }
+}
+
+FrameRange FrameGrabberBase::frames() const { return frames(0, getNumberOfFrames(), 1); }
+
+FrameRange FrameGrabberBase::frames(size_t first, size_t last) const { return frames(first, last, 1); }
+
+FrameRange FrameGrabberBase::frames(size_t first, size_t last, size_t step) const
+{
+  checkInitialization();
+  if (step == 0) { throw std::invalid_argument("Frame range step must be at least 1"); }
+  last = std::min(last, getNumberOfFrames());
+  if (first > last) {
+    throw std::out_of_range("Frame range start " + std::to_string(first) + " is past its end " + std::to_string(last));
+  }
+  return FrameRange(*this, first, last, step);
+}
+
+void FrameGrabberBase::beginSequential(size_t /*first*/, size_t /*step*/) const {}
+
+bool FrameGrabberBase::readSequential(size_t index, cv::Mat &frame) const { return getFrameInto(index, frame); }
+
 double FrameGrabberBase::getFrameRate() const
 {
   if (m_frame_rate_opt.has_value()) { return m_frame_rate_opt.value(); }
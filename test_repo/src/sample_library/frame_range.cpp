@@ -0,0 +1,42 @@
+#include <test_repo/frame_grabber_base.hpp>
+#include <test_repo/frame_range.hpp>
+
+using namespace netxten::utils;
+
+FrameRange::Iterator::Iterator(FrameRange *range, size_t index) : m_range(range), m_index(index) {}
+
+FrameRange::Iterator::reference FrameRange::Iterator::operator*() const { return m_range->m_frame; }
+
+FrameRange::Iterator::pointer FrameRange::Iterator::operator->() const { return &m_range->m_frame; }
+
+FrameRange::Iterator &FrameRange::Iterator::operator++()
+{
+  m_index += m_range->m_step;
+  if (m_index < m_range->m_end) { m_range->read(m_index); }
+  return *this;
+}
+
+FrameRange::Iterator::Proxy FrameRange::Iterator::operator++(int)
+{
+  Proxy previous(m_range->m_frame.clone());
+  ++*this;
+  return previous;
+}
+
+FrameRange::FrameRange(const FrameGrabberBase &grabber, size_t first, size_t last, size_t step)
+  : m_grabber(&grabber), m_first(first), m_end(first + (last - first + step - 1) / step * step), m_step(step)
+{}
+
+FrameRange::Iterator FrameRange::begin()
+{
+  if (empty()) { return end(); }
+  m_grabber->beginSequential(m_first, m_step);
+  read(m_first);
+  return Iterator(this, m_first);
+}
+
+void FrameRange::read(size_t index)
+{
+  // A failed frame is delivered empty so that the remaining frames keep their indices.
+  if (!m_grabber->readSequential(index, m_frame)) { m_frame.release(); }
+}
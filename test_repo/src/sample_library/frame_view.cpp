@@ -0,0 +1,42 @@
+#include <test_repo/frame_view.hpp>
+
+using namespace netxten::types;
+
+FrameView::FrameView(cv::Mat mat, FrameMetadata metadata)
+  : m_mat(std::move(mat)), m_data(m_mat.data), m_rows(m_mat.rows), m_cols(m_mat.cols), m_step(m_mat.step[0]),
+    m_type(m_mat.type()), m_metadata(std::move(metadata))
+{
+  // Only 2D images have a single row stride.
+  if (m_mat.dims > 2) { throw std::invalid_argument("Frame views require a 2D image"); }
+}
+
+FrameView::FrameView(std::shared_ptr<const void> owner,
+  const void *data,
+  int rows,
+  int cols,
+  size_t step,
+  int type,
+  FrameMetadata metadata)
+  : m_owner(std::move(owner)), m_data(static_cast<const uint8_t *>(data)), m_rows(rows), m_cols(cols), m_step(step),
+    m_type(type), m_metadata(std::move(metadata))
+{
+  if (m_step < static_cast<size_t>(m_cols) * CV_ELEM_SIZE(m_type)) {
+    throw std::invalid_argument("Row stride is smaller than a row of the frame");
+  }
+}
+
+bool FrameView::isAligned() const
+{
+  return reinterpret_cast<uintptr_t>(m_data) % ALIGNMENT == 0 && m_step % ALIGNMENT == 0;
+}
+
+bool FrameView::isContinuous() const { return m_step == static_cast<size_t>(m_cols) * CV_ELEM_SIZE(m_type); }
+
+cv::Mat FrameView::mat() const
+{
+  if (!m_mat.empty()) { return m_mat; }
+  if (empty()) { return cv::Mat{}; }
+
+  // OpenCV has no read-only header; callers are told not to write through it.
+  return cv::Mat(m_rows, m_cols, m_type, const_cast<uint8_t *>(m_data), m_step);
+}
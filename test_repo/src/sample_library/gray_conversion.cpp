@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <array>
+#include <test_repo/gray_conversion.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NETXTEN_GRAY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC compiles every intrinsic without per-function target flags.
+#define NETXTEN_TARGET(isa)
+#else
+#define NETXTEN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#else
+#define NETXTEN_GRAY_X86 0
+#endif
+
+using namespace netxten::utils;
+
+namespace {
+
+// Fixed-point BT.601 luma weights of OpenCV's 8-bit BGR2GRAY, in units of 2^-14.
+constexpr int WEIGHT_B = 1868;//*< Blue weight.
+constexpr int WEIGHT_G = 9617;//*< Green weight.
+constexpr int WEIGHT_R = 4899;//*< Red weight.
+constexpr int GRAY_SHIFT = 14;//*< Fixed-point precision of the weights.
+constexpr int GRAY_ROUND = 1 << (GRAY_SHIFT - 1);//*< Rounding term.
+
+/**
+ * @brief Converts the pixels [first, cols) of one row.
+ */
+void convertRowScalar(const uint8_t *bgr, uint16_t *gray, int first, int cols, uint16_t scale)
+{
+  for (int x = first; x < cols; ++x) {
+    const uint8_t *pixel = bgr + 3 * static_cast<ptrdiff_t>(x);
+    const int luma = (WEIGHT_B * pixel[0] + WEIGHT_G * pixel[1] + WEIGHT_R * pixel[2] + GRAY_ROUND) >> GRAY_SHIFT;
+    gray[x] = static_cast<uint16_t>(luma * scale);
+  }
+}
+
+#if NETXTEN_GRAY_X86
+
+// The vector kernels convert 16 pixels per iteration from four 16-byte loads, each holding
+// 4 pixels in its first 12 bytes. The last load ends 4 bytes past the 16 pixels, so the
+// vector loop stops 2 pixels early and the scalar loop finishes the row.
+constexpr int BLOCK_PIXELS = 16;//*< Pixels converted per vector iteration.
+constexpr int BLOCK_SLACK = 2;//*< Pixels that must follow a block so its loads stay in the row.
+
+/**
+ * @brief Spreads 4 pixels into 16-bit (b, g) pairs.
+ */
+NETXTEN_TARGET("sse4.1") __m128i shuffleBlueGreen()
+{
+  return _mm_setr_epi8(0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1);
+}
+
+/**
+ * @brief Spreads 4 pixels into 16-bit (r, 0) pairs; the 0 is replaced by the rounding term.
+ */
+NETXTEN_TARGET("sse4.1") __m128i shuffleRed()
+{
+  return _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+}
+
+// Pairs multiplied with _mm_madd_epi16: b * WEIGHT_B + g * WEIGHT_G and r * WEIGHT_R + 1 * GRAY_ROUND.
+constexpr int PAIR_BLUE_GREEN = (WEIGHT_G << 16) | WEIGHT_B;//*< (b, g) weights.
+constexpr int PAIR_RED_ROUND = (GRAY_ROUND << 16) | WEIGHT_R;//*< (r, 1) weights.
+constexpr int PAIR_ONE = 1 << 16;//*< Sets the second word of a (r, 0) pair to 1.
+
+/**
+ * @brief Computes the 32-bit luma of the 4 pixels at the start of a 16-byte load.
+ */
+NETXTEN_TARGET("sse4.1") inline __m128i luma4(const uint8_t *pixels)
+{
+  const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels));
+  const __m128i bg = _mm_shuffle_epi8(data, shuffleBlueGreen());
+  const __m128i r1 = _mm_or_si128(_mm_shuffle_epi8(data, shuffleRed()), _mm_set1_epi32(PAIR_ONE));
+  const __m128i sum = _mm_add_epi32(
+    _mm_madd_epi16(bg, _mm_set1_epi32(PAIR_BLUE_GREEN)), _mm_madd_epi16(r1, _mm_set1_epi32(PAIR_RED_ROUND)));
+  return _mm_srli_epi32(sum, GRAY_SHIFT);
+}
+
+/**
+ * @brief SSE4.1 row kernel.
+ */
+NETXTEN_TARGET("sse4.1") int convertRowSse41(const uint8_t *bgr, uint16_t *gray, int cols, uint16_t scale)
+{
+  const __m128i factor = _mm_set1_epi16(static_cast<short>(scale));
+  int x = 0;
+  for (; x + BLOCK_PIXELS + BLOCK_SLACK <= cols; x += BLOCK_PIXELS) {
+    const uint8_t *pixels = bgr + 3 * static_cast<ptrdiff_t>(x);
+    const __m128i low = _mm_packs_epi32(luma4(pixels), luma4(pixels + 12));
+    const __m128i high = _mm_packs_epi32(luma4(pixels + 24), luma4(pixels + 36));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(gray + x), _mm_mullo_epi16(low, factor));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(gray + x + 8), _mm_mullo_epi16(high, factor));
+  }
+  return x;
+}
+
+/**
+ * @brief Computes the 32-bit luma of 8 pixels, 4 in each 128-bit lane.
+ */
+NETXTEN_TARGET("avx2") inline __m256i luma8(const uint8_t *pixels)
+{
+  const __m256i data =
+    _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 12)),
+      1);
+  const __m256i bg = _mm256_shuffle_epi8(data, _mm256_broadcastsi128_si256(shuffleBlueGreen()));
+  const __m256i r1 =
+    _mm256_or_si256(_mm256_shuffle_epi8(data, _mm256_broadcastsi128_si256(shuffleRed())), _mm256_set1_epi32(PAIR_ONE));
+  const __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(bg, _mm256_set1_epi32(PAIR_BLUE_GREEN)),
+    _mm256_madd_epi16(r1, _mm256_set1_epi32(PAIR_RED_ROUND)));
+  return _mm256_srli_epi32(sum, GRAY_SHIFT);
+}
+
+/**
+ * @brief AVX2 row kernel.
+ */
+NETXTEN_TARGET("avx2") int convertRowAvx2(const uint8_t *bgr, uint16_t *gray, int cols, uint16_t scale)
+{
+  const __m256i factor = _mm256_set1_epi16(static_cast<short>(scale));
+  int x = 0;
+  for (; x + BLOCK_PIXELS + BLOCK_SLACK <= cols; x += BLOCK_PIXELS) {
+    const uint8_t *pixels = bgr + 3 * static_cast<ptrdiff_t>(x);
+    // Packing works per lane and yields pixels 0-3, 8-11, 4-7, 12-15; restore their order.
+    const __m256i packed = _mm256_packs_epi32(luma8(pixels), luma8(pixels + 24));
+    const __m256i luma = _mm256_permute4x64_epi64(packed, 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(gray + x), _mm256_mullo_epi16(luma, factor));
+  }
+  return x;
+}
+
+// GCC 12 reports the undefined pass-through operands inside its own AVX-512 intrinsics.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+/**
+ * @brief AVX-512BW row kernel.
+ */
+NETXTEN_TARGET("avx512bw") int convertRowAvx512(const uint8_t *bgr, uint16_t *gray, int cols, uint16_t scale)
+{
+  const __m512i blue_green = _mm512_broadcast_i32x4(shuffleBlueGreen());
+  const __m512i red = _mm512_broadcast_i32x4(shuffleRed());
+  const __m512i weights_blue_green = _mm512_set1_epi32(PAIR_BLUE_GREEN);
+  const __m512i weights_red = _mm512_set1_epi32(PAIR_RED_ROUND);
+  const __m512i one = _mm512_set1_epi32(PAIR_ONE);
+  const __m256i factor = _mm256_set1_epi16(static_cast<short>(scale));
+
+  int x = 0;
+  for (; x + BLOCK_PIXELS + BLOCK_SLACK <= cols; x += BLOCK_PIXELS) {
+    const uint8_t *pixels = bgr + 3 * static_cast<ptrdiff_t>(x);
+    __m512i data = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels)));
+    data = _mm512_inserti32x4(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 12)), 1);
+    data = _mm512_inserti32x4(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 24)), 2);
+    data = _mm512_inserti32x4(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 36)), 3);
+
+    const __m512i bg = _mm512_shuffle_epi8(data, blue_green);
+    const __m512i r1 = _mm512_or_si512(_mm512_shuffle_epi8(data, red), one);
+    const __m512i sum =
+      _mm512_add_epi32(_mm512_madd_epi16(bg, weights_blue_green), _mm512_madd_epi16(r1, weights_red));
+    // Narrowing keeps the pixel order, unlike packing.
+    const __m256i luma = _mm512_cvtepi32_epi16(_mm512_srli_epi32(sum, GRAY_SHIFT));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(gray + x), _mm256_mullo_epi16(luma, factor));
+  }
+  return x;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief Queries the CPU for the vector extensions and their OS support.
+ */
+SimdLevel querySimdLevel()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  std::array<int, 4> info{};
+  __cpuid(info.data(), 0);
+  if (info[0] < 7) { return SimdLevel::SCALAR; }
+  __cpuid(info.data(), 1);
+  const bool sse41 = (info[2] & (1 << 19)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+  __cpuidex(info.data(), 7, 0);
+  const bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+  const bool avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 && (xcr0 & 0xE6) == 0xE6;
+#else
+  __builtin_cpu_init();
+  const bool sse41 = __builtin_cpu_supports("sse4.1") != 0;
+  const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+  const bool avx512 = __builtin_cpu_supports("avx512bw") != 0;
+#endif
+  if (avx512) { return SimdLevel::AVX512; }
+  if (avx2) { return SimdLevel::AVX2; }
+  if (sse41) { return SimdLevel::SSE41; }
+  return SimdLevel::SCALAR;
+}
+
+#else
+
+SimdLevel querySimdLevel() { return SimdLevel::SCALAR; }
+
+#endif
+
+}// namespace
+
+SimdLevel netxten::utils::detectSimdLevel()
+{
+  static const SimdLevel level = querySimdLevel();
+  return level;
+}
+
+void netxten::utils::bgrToGray16(const uint8_t *bgr,
+  size_t bgr_step,
+  uint16_t *gray,
+  size_t gray_step,
+  int rows,
+  int cols,
+  uint16_t scale)
+{
+  bgrToGray16(bgr, bgr_step, gray, gray_step, rows, cols, scale, detectSimdLevel());
+}
+
+void netxten::utils::bgrToGray16(const uint8_t *bgr,
+  size_t bgr_step,
+  uint16_t *gray,
+  size_t gray_step,
+  int rows,
+  int cols,
+  uint16_t scale,
+  SimdLevel level)
+{
+  level = std::min(level, detectSimdLevel());
+  for (int y = 0; y < rows; ++y) {
+    const uint8_t *source = bgr + static_cast<size_t>(y) * bgr_step;
+    auto *destination =
+      reinterpret_cast<uint16_t *>(reinterpret_cast<uint8_t *>(gray) + static_cast<size_t>(y) * gray_step);
+
+    int converted = 0;
+#if NETXTEN_GRAY_X86
+    switch (level) {
+    case SimdLevel::AVX512:
+      converted = convertRowAvx512(source, destination, cols, scale);
+      break;
+    case SimdLevel::AVX2:
+      converted = convertRowAvx2(source, destination, cols, scale);
+      break;
+    case SimdLevel::SSE41:
+      converted = convertRowSse41(source, destination, cols, scale);
+      break;
+    case SimdLevel::SCALAR:
+      break;
+    }
+#endif
+    convertRowScalar(source, destination, converted, cols, scale);
+  }
+}
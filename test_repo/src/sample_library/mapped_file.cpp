@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <test_repo/mapped_file.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace netxten::utils;
+
+bool MappedFile::advise(AccessHint hint) const { return advise(hint, 0, m_size); }
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) : m_path(path)
+{
+  HANDLE file = CreateFileA(path.c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,
+    nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    spdlog::error("Failed to open file for mapping: {}", path);
+    throw std::runtime_error("Failed to open file for mapping: " + path);
+  }
+  m_file_handle = file;
+
+  LARGE_INTEGER file_size{};
+  if (GetFileSizeEx(file, &file_size) == 0) {
+    CloseHandle(file);
+    spdlog::error("Failed to get size of file: {}", path);
+    throw std::runtime_error("Failed to get size of file: " + path);
+  }
+  m_size = static_cast<size_t>(file_size.QuadPart);
+  if (m_size == 0) { return; }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    spdlog::error("Failed to create file mapping: {}", path);
+    throw std::runtime_error("Failed to create file mapping: " + path);
+  }
+  m_mapping_handle = mapping;
+
+  m_data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    spdlog::error("Failed to map view of file: {}", path);
+    throw std::runtime_error("Failed to map view of file: " + path);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+  if (m_mapping_handle != nullptr) { CloseHandle(m_mapping_handle); }
+  if (m_file_handle != nullptr) { CloseHandle(m_file_handle); }
+}
+
+bool MappedFile::advise(AccessHint /*hint*/, size_t /*offset*/, size_t /*length*/) const { return false; }
+
+#else
+
+MappedFile::MappedFile(const std::string &path) : m_path(path)
+{
+  m_fd = ::open(path.c_str(), O_RDONLY);
+  if (m_fd < 0) {
+    spdlog::error("Failed to open file for mapping: {}", path);
+    throw std::runtime_error("Failed to open file for mapping: " + path);
+  }
+
+  struct stat file_stat = {};
+  if (::fstat(m_fd, &file_stat) != 0) {
+    ::close(m_fd);
+    spdlog::error("Failed to get size of file: {}", path);
+    throw std::runtime_error("Failed to get size of file: " + path);
+  }
+  m_size = static_cast<size_t>(file_stat.st_size);
+  if (m_size == 0) { return; }
+
+  void *mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+  if (mapping == MAP_FAILED) {
+    ::close(m_fd);
+    spdlog::error("Failed to map file: {}", path);
+    throw std::runtime_error("Failed to map file: " + path);
+  }
+  m_data = static_cast<const uint8_t *>(mapping);
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_data != nullptr) { ::munmap(const_cast<uint8_t *>(m_data), m_size); }
+  if (m_fd >= 0) { ::close(m_fd); }
+}
+
+bool MappedFile::advise(AccessHint hint, size_t offset, size_t length) const
+{
+  if (m_data == nullptr || offset >= m_size || length == 0) { return false; }
+  length = std::min(length, m_size - offset);
+
+  // posix_madvise() requires a page-aligned start.
+  static const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t start = offset / page_size * page_size;
+
+  int advice = POSIX_MADV_NORMAL;
+  switch (hint) {
+  case AccessHint::NORMAL:
+    advice = POSIX_MADV_NORMAL;
+    break;
+  case AccessHint::SEQUENTIAL:
+    advice = POSIX_MADV_SEQUENTIAL;
+    break;
+  case AccessHint::RANDOM:
+    advice = POSIX_MADV_RANDOM;
+    break;
+  case AccessHint::WILL_NEED:
+    advice = POSIX_MADV_WILLNEED;
+    break;
+  }
+  const int result = ::posix_madvise(const_cast<uint8_t *>(m_data) + start, offset + length - start, advice);
+  if (result != 0) {
+    spdlog::debug("posix_madvise failed on {}: {}", m_path, result);
+    return false;
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <test_repo/raw_grabber.hpp>
+
+using namespace netxten::utils;
+
+RawGrabber::RawGrabber(const std::string &file_path, const Layout &layout)
+  : FrameGrabberBase(file_path), m_layout(layout)
+{
+  spdlog::info("RawGrabber::RawGrabber({})", file_path);
+  if (layout.rows <= 0 || layout.cols <= 0) { throw std::invalid_argument("Raw frame size must be positive"); }
+
+  // Odd header sizes would leave the 16-bit pixels misaligned in the mapping.
+  if (layout.header_bytes % sizeof(uint16_t) != 0 || layout.frame_header_bytes % sizeof(uint16_t) != 0) {
+    throw std::invalid_argument("Raw header sizes must be a multiple of 2 bytes");
+  }
+  m_frame_bytes = static_cast<size_t>(layout.rows) * static_cast<size_t>(layout.cols) * sizeof(uint16_t);
+}
+
+void RawGrabber::setup()
+{
+  // The base class has opened the file as a stream; frames are read through the mapping instead.
+  close();
+  m_mapping = std::make_shared<MappedFile>(m_file_path);
+
+  const size_t size = m_mapping->size();
+  if (size < m_layout.header_bytes) {
+    spdlog::error("Raw file {} is shorter than its {} byte header", m_file_path, m_layout.header_bytes);
+    throw std::runtime_error("Raw file is shorter than its header: " + m_file_path);
+  }
+
+  const size_t stride = m_layout.frame_header_bytes + m_frame_bytes;
+  m_total_frames = (size - m_layout.header_bytes) / stride;
+  if (const size_t trailing = (size - m_layout.header_bytes) % stride; trailing != 0) {
+    spdlog::warn("Raw file {} ends with {} bytes of an incomplete frame", m_file_path, trailing);
+  }
+  spdlog::info("RawGrabber::setup: frame size: {}x{}, total frames: {}", m_layout.cols, m_layout.rows, m_total_frames);
+}
+
+size_t RawGrabber::getNumberOfFrames() const
+{
+  checkInitialization();
+  return m_total_frames;
+}
+
+std::pair<int, int> RawGrabber::getFrameSize() const
+{
+  checkInitialization();
+  return { m_layout.rows, m_layout.cols };
+}
+
+std::vector<uint16_t> RawGrabber::getFrame(size_t index) const
+{
+  checkInitialization();
+  check_index(index);
+  const auto *pixels = reinterpret_cast<const uint16_t *>(m_mapping->data() + frame_offset(index));
+  return std::vector<uint16_t>(pixels, pixels + m_frame_bytes / sizeof(uint16_t));
+}
+
+cv::Mat RawGrabber::getCvFrame(size_t index) const
+{
+  cv::Mat frame;
+  getFrameInto(index, frame);
+  return frame;
+}
+
+bool RawGrabber::getFrameInto(size_t index, cv::Mat &frame) const
+{
+  checkInitialization();
+  check_index(index);
+  frame_header(index).copyTo(frame);
+  return true;
+}
+
+netxten::types::FrameView RawGrabber::getFrameView(size_t index) const
+{
+  checkInitialization();
+  check_index(index);
+
+  netxten::types::FrameMetadata metadata;
+  metadata.index = index;
+  if (const double frame_rate = getFrameRate(); frame_rate > 0) {
+    metadata.time = static_cast<double>(index) / frame_rate;
+  }
+  return netxten::types::FrameView(m_mapping,
+    m_mapping->data() + frame_offset(index),
+    m_layout.rows,
+    m_layout.cols,
+    static_cast<size_t>(m_layout.cols) * sizeof(uint16_t),
+    CV_16U,
+    metadata);
+}
+
+void RawGrabber::beginSequential(size_t first, size_t step) const
+{
+  // Consecutive frames are contiguous apart from the frame headers, so the kernel can read
+  // ahead; a strided scan skips most pages and its read-ahead is left to the hints below.
+  m_mapping->advise(step == 1 ? MappedFile::AccessHint::SEQUENTIAL : MappedFile::AccessHint::RANDOM);
+  m_read_ahead_step = step;
+  for (size_t ahead = 0; ahead < READ_AHEAD_FRAMES; ++ahead) {
+    m_mapping->advise(MappedFile::AccessHint::WILL_NEED, frame_offset(first + ahead * step), m_frame_bytes);
+  }
+}
+
+bool RawGrabber::readSequential(size_t index, cv::Mat &frame) const
+{
+  // Page in the frame that enters the read-ahead window while this one is copied.
+  const size_t ahead = index + READ_AHEAD_FRAMES * m_read_ahead_step;
+  if (ahead < m_total_frames) {
+    m_mapping->advise(MappedFile::AccessHint::WILL_NEED, frame_offset(ahead), m_frame_bytes);
+  }
+  frame_header(index).copyTo(frame);
+  return true;
+}
+
+void RawGrabber::check_index(size_t index) const
+{
+  if (index >= m_total_frames) {
+    throw std::out_of_range("Frame number " + std::to_string(index) + " out of range");
+  }
+}
+
+cv::Mat RawGrabber::frame_header(size_t index) const
+{
+  // OpenCV has no read-only header; the result is only ever copied from.
+  return cv::Mat(m_layout.rows, m_layout.cols, CV_16U, const_cast<uint8_t *>(m_mapping->data() + frame_offset(index)));
+}
+
+size_t RawGrabber::frame_offset(size_t index) const
+{
+  return m_layout.header_bytes + index * (m_layout.frame_header_bytes + m_frame_bytes) + m_layout.frame_header_bytes;
+}
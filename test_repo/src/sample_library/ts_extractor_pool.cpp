@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <test_repo/ts_extractor_pool.hpp>
+#include <thread>
+
+using namespace netxten::utils;
+
+TSExtractorPool::TSExtractorPool(const TSFrameExtractor &source, size_t size)
+  : TSExtractorPool(source, size, TSFrameExtractor::Options{})
+{}
+
+TSExtractorPool::TSExtractorPool(const TSFrameExtractor &source,
+  size_t size,
+  const TSFrameExtractor::Options &options)
+  : m_options(options), m_size(size)
+{
+  if (m_size == 0) { m_size = std::max(1U, std::thread::hardware_concurrency()); }
+  m_slots.resize(m_size);
+
+  // The first context is opened right away; the others are cloned from it on demand.
+  m_slots.front().extractor = source.clone(m_options);
+  m_opened = 1;
+  m_stats.contexts = 1;
+  m_total_frames = m_slots.front().extractor->getTotalFrames();
+  spdlog::info("TSExtractorPool: up to {} decoder contexts", m_size);
+}
+
+TSExtractorPool::~TSExtractorPool() = default;
+
+size_t TSExtractorPool::acquire(size_t frame_number)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  ++m_stats.requests;
+  bool waited = false;
+  while (true) {
+    // Prefer the idle context closest behind the frame: it may continue decoding forward.
+    std::optional<size_t> best;
+    for (size_t slot = 0; slot < m_opened; ++slot) {
+      const Slot &candidate = m_slots[slot];
+      if (candidate.busy || candidate.extractor == nullptr) { continue; }
+      if (!best.has_value()) {
+        best = slot;
+        continue;
+      }
+      const auto &current = m_slots[best.value()].last_frame;
+      const bool candidate_behind = candidate.last_frame.has_value() && candidate.last_frame.value() < frame_number;
+      const bool current_behind = current.has_value() && current.value() < frame_number;
+      if (candidate_behind && (!current_behind || candidate.last_frame.value() > current.value())) { best = slot; }
+    }
+
+    // Open another context instead of reusing one that is far from the frame.
+    const bool sequential = best.has_value() && m_slots[best.value()].last_frame.has_value()
+                            && m_slots[best.value()].last_frame.value() + 1 == frame_number;
+    const auto unopened = std::find_if(m_slots.begin(), m_slots.end(), [](const Slot &candidate) {
+      return candidate.extractor == nullptr && !candidate.busy;
+    });
+    if (!sequential && unopened != m_slots.end()
+        && (!best.has_value() || m_slots[best.value()].last_frame.has_value())) {
+      const auto slot = static_cast<size_t>(std::distance(m_slots.begin(), unopened));
+      m_opened = std::max(m_opened, slot + 1);
+      unopened->busy = true;
+
+      // Open the context without blocking the other readers; the first one is never replaced.
+      lock.unlock();
+      try {
+        auto extractor = m_slots.front().extractor->clone(m_options);
+        lock.lock();
+        m_slots[slot].extractor = std::move(extractor);
+        ++m_stats.contexts;
+      } catch (...) {
+        lock.lock();
+        m_slots[slot].busy = false;
+        m_cv.notify_all();
+        throw;
+      }
+      if (waited) { ++m_stats.waits; }
+      return slot;
+    }
+
+    if (best.has_value()) {
+      m_slots[best.value()].busy = true;
+      if (sequential) { ++m_stats.sequential; }
+      if (waited) { ++m_stats.waits; }
+      return best.value();
+    }
+
+    // Every context is in use.
+    waited = true;
+    m_cv.wait(lock);
+  }
+}
+
+void TSExtractorPool::release(size_t slot, std::optional<size_t> frame_number)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots[slot].busy = false;
+    m_slots[slot].last_frame = frame_number;
+  }
+  m_cv.notify_one();
+}
+
+std::optional<std::vector<uint8_t>> TSExtractorPool::getFrame(size_t frame_number)
+{
+  if (frame_number >= m_total_frames) {
+    throw std::out_of_range("Frame number " + std::to_string(frame_number) + " out of range");
+  }
+
+  const size_t slot = acquire(frame_number);
+  std::optional<std::vector<uint8_t>> frame;
+  try {
+    // The slot is reserved, so its extractor is only touched by this thread.
+    frame = m_slots[slot].extractor->getFrame(frame_number);
+  } catch (...) {
+    release(slot, std::nullopt);
+    throw;
+  }
+  release(slot, frame.has_value() ? std::optional<size_t>(frame_number) : std::nullopt);
+  return frame;
+}
+
+void TSExtractorPool::recycleFrame(std::vector<uint8_t> &&buffer)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t slot = 0; slot < m_opened; ++slot) {
+    // Idle contexts are not used by other threads while the lock is held.
+    if (!m_slots[slot].busy && m_slots[slot].extractor != nullptr) {
+      m_slots[slot].extractor->recycleFrame(std::move(buffer));
+      return;
+    }
+  }
+  buffer = std::vector<uint8_t>{};
+}
+
+TSExtractorPool::Stats TSExtractorPool::getStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
@@ -1,9 +1,23 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <spdlog/spdlog.h>
 #include <test_repo/frame.hpp>
+#include <test_repo/frame_cache.hpp>
+#include <test_repo/file_follower.hpp>
+#include <test_repo/mapped_file.hpp>
 #include <test_repo/ts_frame_extractor.hpp>
+#include <test_repo/ts_frame_index.hpp>
 
 // FFmpeg headers
 extern "C" {
@@ -11,12 +25,254 @@ extern "C" {
 #include <libavformat/avformat.h>
 #include <libavutil/avutil.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 }
 
 using namespace netxten::utils;
 using namespace netxten::types;
 
+namespace {
+
+constexpr int CUSTOM_IO_BUFFER_SIZE = 64 * 1024;//*< Size of the buffer FFmpeg demuxes custom I/O sources from.
+
+/**
+ * @brief Byte source behind a custom AVIOContext.
+ */
+class CustomIOSource
+{
+public:
+  CustomIOSource() = default;
+  virtual ~CustomIOSource() = default;
+  CustomIOSource(const CustomIOSource &) = delete;
+  CustomIOSource &operator=(const CustomIOSource &) = delete;
+  CustomIOSource(CustomIOSource &&) = delete;
+  CustomIOSource &operator=(CustomIOSource &&) = delete;
+
+  /**
+   * @brief Reads up to size bytes; returns the count, or AVERROR_EOF at the end.
+   */
+  virtual int read(uint8_t *buffer, int size) = 0;
+
+  /**
+   * @brief Moves the read position like fseek(); returns the new position or -1.
+   */
+  virtual int64_t seek(int64_t offset, int whence) = 0;
+
+  /**
+   * @brief Gets the total size in bytes, or -1 if unknown.
+   */
+  virtual int64_t size() const = 0;
+};
+
+/**
+ * @brief Custom I/O source over a byte span.
+ */
+class MemoryReader : public CustomIOSource
+{
+public:
+  MemoryReader(const uint8_t *data, size_t size) : m_data(data), m_size(static_cast<int64_t>(size)) {}
+
+  int read(uint8_t *buffer, int size) override
+  {
+    const int64_t remaining = m_size - m_position;
+    if (remaining <= 0) { return AVERROR_EOF; }
+    const auto count = static_cast<int>(std::min<int64_t>(remaining, size));
+    std::memcpy(buffer, m_data + m_position, static_cast<size_t>(count));
+    m_position += count;
+    return count;
+  }
+
+  int64_t seek(int64_t offset, int whence) override
+  {
+    switch (whence) {
+    case SEEK_SET:
+      break;
+    case SEEK_CUR:
+      offset += m_position;
+      break;
+    case SEEK_END:
+      offset += m_size;
+      break;
+    default:
+      return -1;
+    }
+    if (offset < 0 || offset > m_size) { return -1; }
+    m_position = offset;
+    return offset;
+  }
+
+  int64_t size() const override { return m_size; }
+
+private:
+  const uint8_t *m_data = nullptr;//*< Start of the span.
+  int64_t m_size = 0;//*< Size of the span in bytes.
+  int64_t m_position = 0;//*< Offset of the next byte to read.
+};
+
+/**
+ * @brief Custom I/O source over a file that is still being written.
+ */
+class FollowReader : public CustomIOSource
+{
+public:
+  FollowReader(const std::string &path, const FileFollower::Options &options, const std::atomic<bool> &stop)
+    : m_follower(path, options, stop)
+  {}
+
+  int read(uint8_t *buffer, int size) override
+  {
+    const int count = m_waiting ? m_follower.read(buffer, size) : m_follower.readAvailable(buffer, size);
+    return count > 0 ? count : AVERROR_EOF;
+  }
+
+  int64_t seek(int64_t offset, int whence) override { return m_follower.seek(offset, whence); }
+
+  int64_t size() const override { return m_follower.size(); }
+
+  /**
+   * @brief Chooses between waiting for the writer and reporting the current end of the file.
+   */
+  void setWaiting(bool waiting) { m_waiting = waiting; }
+
+private:
+  FileFollower m_follower;//*< Waits for the writer at the end of the file.
+  bool m_waiting = true;//*< Flag to wait for the writer at the end instead of reporting the end.
+};
+
+/**
+ * @brief AVIOContext read callback.
+ */
+int readCustomIO(void *opaque, uint8_t *buffer, int buffer_size)
+{
+  return static_cast<CustomIOSource *>(opaque)->read(buffer, buffer_size);
+}
+
+/**
+ * @brief AVIOContext seek callback.
+ */
+int64_t seekCustomIO(void *opaque, int64_t offset, int whence)
+{
+  auto *source = static_cast<CustomIOSource *>(opaque);
+  if ((whence & AVSEEK_SIZE) != 0) { return source->size(); }
+  return source->seek(offset, whence & ~AVSEEK_FORCE);
+}
+
+/**
+ * @brief Frees a custom I/O context created by openCustomIO(), including its source.
+ */
+void freeCustomIO(AVIOContext *&io)
+{
+  if (io == nullptr) { return; }
+  delete static_cast<CustomIOSource *>(io->opaque);
+  av_freep(&io->buffer);
+  avio_context_free(&io);
+}
+
+/**
+ * @brief Creates a read-only, seekable custom I/O context that takes ownership of a source.
+ *
+ * @return The I/O context, or nullptr if an allocation failed.
+ */
+AVIOContext *openCustomIO(std::unique_ptr<CustomIOSource> source)
+{
+  auto *buffer = static_cast<unsigned char *>(av_malloc(CUSTOM_IO_BUFFER_SIZE));
+  if (buffer == nullptr) { return nullptr; }
+  AVIOContext *io =
+    avio_alloc_context(buffer, CUSTOM_IO_BUFFER_SIZE, 0, source.get(), &readCustomIO, nullptr, &seekCustomIO);
+  if (io == nullptr) {
+    av_free(buffer);
+    return nullptr;
+  }
+  source.release();
+  return io;
+}
+
+/**
+ * @brief Closes a container, including the custom I/O context of a memory source.
+ */
+void closeContainer(AVFormatContext *&container)
+{
+  if (container == nullptr) { return; }
+  // FFmpeg leaves custom I/O contexts to the caller.
+  AVIOContext *io = (container->flags & AVFMT_FLAG_CUSTOM_IO) != 0 ? container->pb : nullptr;
+  avformat_close_input(&container);
+  freeCustomIO(io);
+}
+
+/**
+ * @brief Reads the size and modification time used to validate the index sidecar.
+ */
+std::optional<std::pair<uint64_t, int64_t>> sourceFileStamp(const std::string &filename)
+{
+  std::error_code error;
+  const auto size = std::filesystem::file_size(filename, error);
+  if (error) { return std::nullopt; }
+  const auto mtime = std::filesystem::last_write_time(filename, error);
+  if (error) { return std::nullopt; }
+  return std::make_pair(static_cast<uint64_t>(size), static_cast<int64_t>(mtime.time_since_epoch().count()));
+}
+
+/**
+ * @brief Maps an output pixel format to the corresponding FFmpeg pixel format.
+ */
+AVPixelFormat toAVPixelFormat(PixelFormat format)
+{
+  switch (format) {
+  case PixelFormat::BGR24:
+    return AV_PIX_FMT_BGR24;
+  case PixelFormat::GRAY8:
+    return AV_PIX_FMT_GRAY8;
+  case PixelFormat::GRAY16:
+    return AV_PIX_FMT_GRAY16;
+  case PixelFormat::YUV420P:
+    return AV_PIX_FMT_YUV420P;
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/**
+ * @brief Resolves a requested output size against the size of the decoded frames.
+ *
+ * A zero dimension is derived from the other one and the source aspect ratio; a zero
+ * size keeps the source size.
+ */
+std::pair<int, int> resolveOutputSize(const FrameSize &requested, int width, int height)
+{
+  int out_width = static_cast<int>(requested.width);
+  int out_height = static_cast<int>(requested.height);
+  if (out_width == 0 && out_height == 0) { return { width, height }; }
+  if (out_width == 0) {
+    out_width = std::max(1, static_cast<int>(std::lround(static_cast<double>(out_height) * width / height)));
+  } else if (out_height == 0) {
+    out_height = std::max(1, static_cast<int>(std::lround(static_cast<double>(out_width) * height / width)));
+  }
+  return { out_width, out_height };
+}
+
+/**
+ * @brief Checks whether plane 0 of a decoded frame already holds full-range 8-bit luma.
+ *
+ * Such frames can be turned into gray output without going through swscale.
+ */
+bool hasFullRangeLuma8(const AVFrame *frame)
+{
+  const auto format = static_cast<AVPixelFormat>(frame->format);
+  if (format == AV_PIX_FMT_GRAY8 || format == AV_PIX_FMT_YUVJ420P || format == AV_PIX_FMT_YUVJ422P
+      || format == AV_PIX_FMT_YUVJ444P || format == AV_PIX_FMT_YUVJ440P || format == AV_PIX_FMT_YUVJ411P) {
+    return true;
+  }
+  if (frame->color_range != AVCOL_RANGE_JPEG) { return false; }
+
+  // Planar YUV with an 8-bit luma plane and a full-range flag.
+  const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(format);
+  return desc != nullptr && (desc->flags & AV_PIX_FMT_FLAG_PLANAR) != 0 && (desc->flags & AV_PIX_FMT_FLAG_RGB) == 0
+         && desc->nb_components >= 3 && desc->comp[0].plane == 0 && desc->comp[0].depth == 8
+         && desc->comp[0].step == 1;
+}
+
+}// namespace
+
 /**
  * @brief Internal implementation for TSFrameExtractor.
  *
@@ -38,18 +294,43 @@ public:
    * Opens the video file, initializes the FFmpeg context, builds the keyframe index.
    *
    * @param filename The path to the video file.
+   * @param options The decode options.
+   * @param shared_index A complete index of the same file to use instead of building one.
+   */
+  TSFrameExtractorImpl(const std::string &filename,
+    const TSFrameExtractor::Options &options,
+    std::shared_ptr<TSFrameIndex> shared_index = nullptr);
+
+  /**
+   * @brief Constructs the TSFrameExtractorImpl over a video held in memory.
+   *
+   * @param data The video data; must outlive the extractor.
+   * @param size The size of the video data in bytes.
+   * @param options The decode options; the index cache is disabled.
+   * @param shared_index A complete index of the same video to use instead of building one.
    */
-  explicit TSFrameExtractorImpl(const std::string &filename);
+  TSFrameExtractorImpl(const uint8_t *data,
+    size_t size,
+    const TSFrameExtractor::Options &options,
+    std::shared_ptr<TSFrameIndex> shared_index = nullptr);
 
   /**
    * @brief Destructor that cleans up all allocated FFmpeg resources.
    */
   ~TSFrameExtractorImpl();
 
+  /**
+   * @brief Opens another implementation on the same source that shares the index.
+   *
+   * @param options The decode options of the new implementation.
+   * @return The new implementation.
+   */
+  std::unique_ptr<TSFrameExtractorImpl> clone(const TSFrameExtractor::Options &options) const;
+
   /**
    * @brief Retrieves a specific frame by frame number.
    *
-   * Returns the frame data in BGR24 format as a vector of bytes.
+   * Returns the frame data in the configured output format as a vector of bytes.
    *
    * @param frame_number The zero-based index of the frame to retrieve.
    * @return std::optional containing the frame data if successful, std::nullopt
@@ -57,6 +338,56 @@ public:
    */
   std::optional<std::vector<uint8_t>> getFrame(size_t frame_number);
 
+  /**
+   * @brief Retrieves a frame, giving up between decoded frames once the flag is set.
+   *
+   * @param frame_number The zero-based index of the frame to retrieve.
+   * @param cancel Flag that abandons the request.
+   * @return std::optional containing the frame data if successful, std::nullopt on
+   * failure or cancellation.
+   */
+  std::optional<std::vector<uint8_t>> getFrame(size_t frame_number, const std::atomic<bool> &cancel);
+
+  /**
+   * @brief Streams the given frames to a callback in ascending order, one seek per GOP.
+   *
+   * @param frame_numbers The frames to retrieve, in any order.
+   * @param callback Receives each decoded frame.
+   */
+  void getFrames(const std::vector<size_t> &frame_numbers, const TSFrameExtractor::FrameCallback &callback);
+
+  /**
+   * @brief Decodes the keyframes at or before the given frames, optionally downscaled.
+   *
+   * @param frame_numbers The frames to find keyframes for, in any order.
+   * @param size The thumbnail size; a zero dimension keeps the aspect ratio.
+   * @param callback Receives the frame number of each keyframe and its image.
+   */
+  void getKeyframeThumbnails(const std::vector<size_t> &frame_numbers,
+    FrameSize size,
+    const TSFrameExtractor::FrameCallback &callback);
+
+  /**
+   * @brief Returns an output buffer to the pool so later frames can reuse its memory.
+   *
+   * @param buffer The buffer to recycle.
+   */
+  void recycleFrame(std::vector<uint8_t> &&buffer);
+
+  /**
+   * @brief Gets the decode and allocation counters.
+   *
+   * @return The accumulated decode statistics.
+   */
+  TSFrameExtractor::DecodeStats getDecodeStats() const;
+
+  /**
+   * @brief Gets the decoded frame cache counters.
+   *
+   * @return The cache statistics.
+   */
+  FrameCache::Stats getCacheStats() const;
+
   /**
    * @brief Gets the total number of frames in the video.
    *
@@ -64,6 +395,39 @@ public:
    */
   size_t getTotalFrames() const;
 
+  /**
+   * @brief Resolves a presentation timestamp to a frame number through the index.
+   *
+   * @param pts The presentation timestamp.
+   * @param match How the timestamp is matched.
+   * @return The frame number, or std::nullopt if no frame matches.
+   */
+  std::optional<size_t> findFrameByPts(int64_t pts, TSFrameExtractor::TimestampMatch match) const;
+
+  /**
+   * @brief Converts a time since the first frame to a presentation timestamp.
+   *
+   * @param seconds The time in seconds.
+   * @return The timestamp, or std::nullopt if nothing is indexed yet.
+   */
+  std::optional<int64_t> ptsAtTime(double seconds) const;
+
+  /**
+   * @brief Gets the presentation timestamp of a frame.
+   *
+   * @param frame_number The frame number.
+   * @return The timestamp, or std::nullopt if the frame is not indexed.
+   */
+  std::optional<int64_t> getFramePts(size_t frame_number) const;
+
+  /**
+   * @brief Gets the time of a frame since the first frame.
+   *
+   * @param frame_number The frame number.
+   * @return The time in seconds, or std::nullopt if the frame is not indexed.
+   */
+  std::optional<double> getFrameTime(size_t frame_number) const;
+
   /**
    * @brief Retrieves the video frame rate.
    *
@@ -92,99 +456,480 @@ public:
    */
   std::optional<FrameSize> getFrameSize() const;
 
+  /**
+   * @brief Checks whether the index was loaded from the sidecar file.
+   *
+   * @return true if the index came from the cache.
+   */
+  bool isIndexCached() const;
+
+  /**
+   * @brief Checks whether the file is demuxed from a memory mapping.
+   *
+   * @return true if the file was mapped.
+   */
+  bool isMemoryMapped() const;
+
+  /**
+   * @brief Gets the fraction of the file that has been indexed.
+   *
+   * @return Indexing progress between 0 and 1.
+   */
+  double getIndexingProgress() const;
+
+  /**
+   * @brief Checks whether the index covers the whole file.
+   *
+   * @return true if indexing has finished.
+   */
+  bool isIndexComplete() const;
+
+  /**
+   * @brief Waits for background indexing to finish.
+   *
+   * @param timeout_seconds Maximum time to wait in seconds.
+   * @return true if the index is complete.
+   */
+  bool waitForIndex(double timeout_seconds) const;
+
+  /**
+   * @brief Gets the heap memory held by the frame index.
+   *
+   * @return Index size in bytes.
+   */
+  size_t getIndexMemoryUsage() const;
+
+  /**
+   * @brief Waits until at least count frames are available or indexing has finished.
+   *
+   * @param count The frame count to wait for.
+   * @param timeout_seconds Maximum time to wait in seconds.
+   * @return true if count frames are available.
+   */
+  bool waitForFrames(size_t count, double timeout_seconds) const;
+
+  /**
+   * @brief Stops following the file; the index is completed with the frames read so far.
+   */
+  void stopFollowing();
+
+  /**
+   * @brief Checks whether the file is still being followed.
+   *
+   * @return true until following stops.
+   */
+  bool isFollowing() const;
+
+  /**
+   * @brief Waits for indexing to finish and returns the index for sharing.
+   *
+   * @return The complete frame index.
+   * @throws std::runtime_error if indexing failed.
+   */
+  std::shared_ptr<TSFrameIndex> getCompleteIndex() const;
+
+  /**
+   * @brief Gets the video filename.
+   *
+   * @return The path the extractor was opened with.
+   */
+  const std::string &getFilename() const;
+
+  /**
+   * @brief Get the output pixel format.
+   *
+   * @return PixelFormat
+   */
+  PixelFormat getOutputFormat() const;
+
 private:
   int m_current_frame_index = -1;//*< Current frame index (for sequential decoding).
   bool m_sequential_active = false;//*< Flag indicating if sequential decoding is active.
-  std::string m_filename;//*< Video filename.
+  std::string m_filename;//*< Video filename; empty for memory sources.
+  TSFrameExtractor::Options m_options;//*< Decode options.
+  std::unique_ptr<MappedFile> m_mapping;//*< Mapping of the video file, if memory mapping is enabled.
+  const uint8_t *m_memory_data = nullptr;//*< Video data demuxed through a custom I/O context, if any.
+  size_t m_memory_size = 0;//*< Size of m_memory_data in bytes.
   AVFormatContext *m_container = nullptr;//*< FFmpeg format context.
   AVStream *m_stream = nullptr;//*< Pointer to the video stream.
   AVCodecContext *m_decoder_context = nullptr;//*< Cached decoder context.
-  std::optional<int> m_frame_count = std::nullopt;//*< Total frame count.
-  std::optional<FrameSize> m_frame_size = std::nullopt;//*< Frame size (width, height).
-  std::map<size_t, TSFrameInfo> m_keyframe_positions;//*< Mapping of keyframe indices to frame info.
-  std::unordered_map<int64_t, int> m_frame_indices;//*< Mapping of packet pts to frame indices.
+  bool m_decoder_draining = false;//*< Flag indicating the decoder was sent the end-of-stream packet.
+  std::optional<int> m_frame_count = std::nullopt;//*< Frame count estimated from the duration, used until the index is complete.
+  std::optional<FrameSize> m_frame_size = std::nullopt;//*< Size of the returned frames (width, height).
+  std::shared_ptr<TSFrameIndex> m_index = std::make_shared<TSFrameIndex>();//*< Sorted pts and keyframe index.
+  mutable std::mutex m_index_mutex;//*< Guards the indexing completion state.
+  mutable std::condition_variable m_index_cv;//*< Signalled when indexing finishes.
+  std::thread m_index_thread;//*< Background indexing thread.
+  std::atomic<bool> m_stop_indexing{ false };//*< Requests the background indexing thread to stop.
+  std::atomic<bool> m_stop_following{ false };//*< Makes followed reads report the end of the file.
+  const std::atomic<bool> *m_cancel = nullptr;//*< Cancel flag of the request being decoded, if any.
+  std::atomic<bool> m_index_complete{ false };//*< Flag indicating the index covers the whole file.
+  bool m_indexing_done = false;//*< Flag indicating indexing finished or failed, guarded by m_index_mutex.
+  std::atomic<int64_t> m_indexed_bytes{ 0 };//*< Byte position reached by the indexer.
+  int64_t m_source_size = 0;//*< Size of the video in bytes, if known.
+  AVPacket *m_packet = nullptr;//*< Packet reused for every demuxed packet.
+  AVFrame *m_frame = nullptr;//*< Frame reused for every decoded frame.
+  SwsContext *m_sws_context = nullptr;//*< Cached scaler context for the output conversion.
+  AVCodecContext *m_thumbnail_decoder = nullptr;//*< Keyframe-only decoder for thumbnails.
+  SwsContext *m_thumbnail_sws_context = nullptr;//*< Cached scaler context for thumbnails.
+  std::vector<std::vector<uint8_t>> m_buffer_pool;//*< Recycled output buffers.
+  TSFrameExtractor::DecodeStats m_stats;//*< Decode and allocation counters.
+  bool m_index_cached = false;//*< Flag indicating the index was loaded from the sidecar file.
+  std::unique_ptr<FrameCache> m_frame_cache;//*< Decoded frame cache, if enabled.
+  std::optional<size_t> m_last_requested = std::nullopt;//*< Frame number of the previous getFrame() call.
+  std::vector<std::vector<uint8_t>> m_reverse_frames;//*< Consecutive frames decoded for reverse playback.
+  size_t m_reverse_first = 0;//*< Frame number of m_reverse_frames.front().
+  bool m_playing_backward = false;//*< Flag indicating the current request steps backwards.
+
+  /**
+   * @brief Opens the container, locates the video stream and sets up the index.
+   *
+   * @param shared_index A complete index of the same video, or nullptr.
+   */
+  void initialize(std::shared_ptr<TSFrameIndex> shared_index);
+
+  /**
+   * @brief Opens the video and reads its stream information.
+   *
+   * @return A new format context owned by the caller.
+   * @throws std::runtime_error if the video cannot be opened or probed.
+   */
+  AVFormatContext *open_container() const;
+
+  /**
+   * @brief Estimates the frame count from the stream duration and frame rate.
+   *
+   * @return The estimated number of frames.
+   */
+  int estimate_frame_count() const;
 
   /**
    * @brief Builds the keyframe index from the video container.
    *
-   * Iterates through the packets in the video, identifying keyframes based on a minimum
-   * interval, and calculates the total number of frames.
+   * Iterates through the packets in the video, recording every keyframe with its
+   * timestamps and byte position, and the timestamp of every frame.
    */
   void build_keyframe_index();
 
   /**
-   * @brief Seeks to the nearest previous keyframe for the given frame number.
+   * @brief Demuxes all packets of a container and adds them to the index.
    *
-   * @param frame_number The target frame number.
-   * @return Optional keyframe index if found; std::nullopt otherwise.
+   * Index entries are published to readers in batches of INDEX_BATCH_SIZE packets.
+   *
+   * @param container The container to read; its read position is advanced to the end.
+   * @param packet A packet used for demuxing.
+   * @return true if the whole file was scanned, false if indexing was stopped.
    */
-  std::optional<size_t> seek_to_keyframe(size_t frame_number);
+  bool scan_packets(AVFormatContext *container, AVPacket *packet);
 
   /**
-   * @brief Decodes frames until a specified condition is met.
-   *
-   * This helper function reads packets from the container and decodes frames,
-   * incrementing the current frame index. When the provided condition (a predicate on the
-   * frame index) returns true, the frame is converted to BGR24 and returned.
+   * @brief Background thread body: indexes the file with its own demuxer.
+   */
+  void index_in_background();
+
+  /**
+   * @brief Marks indexing as finished and wakes up waiting readers.
    *
-   * @param current_frame_idx Reference to the current frame index.
-   * @param condition A callable that takes an int (frame index) and returns true when the
-   * target frame is reached.
-   * @return An optional vector of bytes containing the frame data in BGR24 format.
+   * @param complete Whether the index covers the whole file.
    */
-  std::optional<std::vector<uint8_t>> decode_frames_until_condition(size_t current_frame_idx,
-    const std::function<bool(size_t)> &condition);
+  void finish_indexing(bool complete);
 
   /**
-   * @brief Decodes frames from a starting index until the target frame index is reached.
+   * @brief Checks whether the index already knows the GOP containing a frame.
    *
-   * @param start_idx The frame index from which decoding should start.
-   * @param target_idx The target frame index to decode until.
-   * @return An optional vector of bytes containing the target frame data.
+   * @param frame_number The frame to look up.
+   * @return true if a keyframe seek can be used for the frame.
    */
-  std::optional<std::vector<uint8_t>> decode_frames_until(size_t start_idx, size_t target_idx);
+  bool index_covers(size_t frame_number) const;
 
   /**
-   * @brief Decodes the next available frame in sequential mode.
+   * @brief Locates a frame with a timestamp seek when it is not indexed yet.
    *
-   * Reads packets without seeking and decodes the first frame available. The frame is
-   * converted to BGR24.
+   * Seeks to the timestamp derived from the frame rate and decodes until a frame whose
+   * timestamp maps to the requested frame number is reached.
    *
+   * @param frame_number The target frame number.
    * @return An optional vector of bytes containing the frame data.
    */
-  std::optional<std::vector<uint8_t>> decode_next_sequential_frame();
+  std::optional<std::vector<uint8_t>> decode_by_timestamp(size_t frame_number);
 
   /**
-   * @brief Set the sequence active object.
+   * @brief Checks whether the request being decoded has been cancelled.
    *
-   * @param active
+   * @return true if the caller set the cancel flag of the current request.
    */
-  void set_sequence_active(bool active);
-};
+  bool cancelled() const { return m_cancel != nullptr && m_cancel->load(std::memory_order_relaxed); }
 
-TSFrameExtractor::TSFrameExtractorImpl::TSFrameExtractorImpl(const std::string &filename) : m_filename(filename)
-{
-  spdlog::info("Creating TSFrameExtractorImpl");
+  /**
+   * @brief Gets the path of the index sidecar file.
+   *
+   * @return The configured sidecar path, or the video path with ".idx" appended.
+   */
+  std::string index_cache_path() const;
 
-  // Check if the file exists using C++17 filesystem.
-  if (!std::filesystem::exists(filename)) { throw std::runtime_error("Video file not found: " + filename); }
+  /**
+   * @brief Loads the frame index from the memory-mapped sidecar file.
+   *
+   * @return true if the index was loaded, false if it has to be rebuilt.
+   */
+  bool load_index_cache();
 
-  // Open the input file/container.
-  int ret = avformat_open_input(&m_container, filename.c_str(), nullptr, nullptr);
-  if (ret < 0) {
-    std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf = {};
-    av_strerror(ret, errbuf.data(), errbuf.size());
-    spdlog::error("Failed to open video file: {}", errbuf.data());
-    throw std::runtime_error(std::string("Failed to open video file: ") + errbuf.data());
-  }
+  /**
+   * @brief Writes the frame index to the sidecar file.
+   *
+   * Failures are logged and otherwise ignored; the cache is only an optimization.
+   */
+  void save_index_cache() const;
 
-  // Retrieve stream information.
-  ret = avformat_find_stream_info(m_container, nullptr);
-  if (ret < 0) {
-    std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf = {};
-    av_strerror(ret, errbuf.data(), errbuf.size());
-    spdlog::error("Failed to find stream info: {}", errbuf.data());
-    throw std::runtime_error(std::string("Failed to find stream info: ") + errbuf.data());
+  /**
+   * @brief Locates and decodes a frame through the sequential, cached or seeking path.
+   *
+   * @param frame_number The zero-based index of the frame to retrieve.
+   * @return std::optional containing the frame data if successful.
+   */
+  std::optional<std::vector<uint8_t>> decode_frame(size_t frame_number);
+
+  /**
+   * @brief Serves a backward step from the reverse playback buffer.
+   *
+   * If the frame is not buffered, the GOP containing it is decoded once, forward from its
+   * keyframe, and the frames up to the requested one are kept, limited to
+   * reverse_buffer_bytes. Later backward steps are then handed out from the buffer
+   * without decoding.
+   *
+   * @param frame_number The requested frame, one before the previously requested one.
+   * @return The frame data, or std::nullopt if the step is too large to buffer.
+   */
+  std::optional<std::vector<uint8_t>> decode_reverse(size_t frame_number);
+
+  /**
+   * @brief Returns the frames of the reverse playback buffer to the buffer pool.
+   */
+  void release_reverse_frames();
+
+  /**
+   * @brief Copies a frame out of the decoded frame cache.
+   *
+   * @param frame_number The frame to look up.
+   * @return The frame data on a cache hit, std::nullopt on a miss.
+   */
+  std::optional<std::vector<uint8_t>> lookup_cached_frame(size_t frame_number);
+
+  /**
+   * @brief Converts m_frame and stores it in the decoded frame cache.
+   *
+   * @param frame_number The frame number of m_frame.
+   */
+  void cache_decoded_frame(size_t frame_number);
+
+  /**
+   * @brief Seeks to the nearest previous keyframe for the given frame number.
+   *
+   * @param frame_number The target frame number.
+   * @return Optional keyframe index if found; std::nullopt otherwise.
+   */
+  std::optional<size_t> seek_to_keyframe(size_t frame_number);
+
+  /**
+   * @brief Seeks the demuxer to a keyframe, by byte offset where the container allows it.
+   *
+   * @param keyframe The keyframe entry.
+   * @return The FFmpeg result of the seek; negative on failure.
+   */
+  int seek_container(const TSFrameIndex::Keyframe &keyframe);
+
+  /**
+   * @brief Decides between seeking and decoding forward to reach a frame.
+   *
+   * @param target The requested frame.
+   * @param keyframe The keyframe at or before target, if indexed.
+   * @return true if seeking to the keyframe is estimated to be cheaper, or the decoder
+   * cannot reach target by decoding forward.
+   */
+  bool plan_seek(size_t target, const std::optional<TSFrameIndex::Keyframe> &keyframe) const;
+
+  /**
+   * @brief Allocates a decoder context for the video stream without opening it.
+   *
+   * @return A new decoder context owned by the caller.
+   * @throws std::runtime_error if no decoder is available.
+   */
+  AVCodecContext *allocate_decoder() const;
+
+  /**
+   * @brief Picks the decoder lowres level for the requested output size.
+   *
+   * @param max_lowres The highest level the codec supports.
+   * @return The largest level whose frames are still at least as large as the output,
+   * or 0 if reduced-resolution decoding is disabled or not useful.
+   */
+  int select_lowres(int max_lowres) const;
+
+  /**
+   * @brief Creates and opens the keyframe-only decoder used for thumbnails.
+   */
+  void open_thumbnail_decoder();
+
+  /**
+   * @brief Decodes the keyframe packet at the current demuxer position into m_frame.
+   *
+   * @param keyframe The keyframe to decode; packets before it are skipped without decoding.
+   * @return true if m_frame holds the keyframe.
+   */
+  bool decode_keyframe(const TSFrameIndex::Keyframe &keyframe);
+
+  /**
+   * @brief Creates and opens the cached decoder context if it does not exist yet.
+   *
+   * Applies the threading options before the decoder is opened.
+   */
+  void open_decoder();
+
+  /**
+   * @brief Discards all frames buffered in the decoder, e.g. after a seek.
+   */
+  void flush_decoder();
+
+  /**
+   * @brief Receives the next decoded frame into m_frame.
+   *
+   * Drains frames already buffered in the decoder before demuxing more packets, so no
+   * decoded frame is dropped between calls. At the end of the file the decoder is put in
+   * draining mode so frames held back by the threading pipeline are still returned.
+   *
+   * @return true if m_frame holds a new frame, false on end of stream or error.
+   */
+  bool receive_next_frame();
+
+  /**
+   * @brief Converts m_frame to the output format into a pooled buffer.
+   *
+   * Gray output is copied or widened straight from the luma plane when the decoder
+   * produces full-range luma; everything else goes through the cached scaler.
+   *
+   * @return An optional vector of bytes containing the frame data in the output format.
+   */
+  std::optional<std::vector<uint8_t>> convert_frame();
+
+  /**
+   * @brief Converts and resizes m_frame into the given buffer using a cached scaler context.
+   *
+   * @param context The scaler context to reuse; replaced if the geometry changed.
+   * @param width The output width.
+   * @param height The output height.
+   * @param buffer The destination buffer, sized for the output format and size.
+   * @return true if the whole frame was converted.
+   */
+  bool scale_frame(SwsContext *&context, int width, int height, std::vector<uint8_t> &buffer);
+
+  /**
+   * @brief Takes a buffer from the pool, or allocates one if the pool is empty.
+   *
+   * @param size The required buffer size in bytes.
+   * @return A buffer of exactly size bytes.
+   */
+  std::vector<uint8_t> acquire_buffer(size_t size);
+
+  /**
+   * @brief Decodes frames until a specified condition is met.
+   *
+   * This helper function reads packets from the container and decodes frames,
+   * incrementing the current frame index. When the provided condition (a predicate on the
+   * frame index) returns true, the frame is converted to the output format and returned.
+   *
+   * @param current_frame_idx Reference to the current frame index.
+   * @param condition A callable that takes an int (frame index) and returns true when the
+   * target frame is reached.
+   * @return An optional vector of bytes containing the frame data in the output format.
+   */
+  std::optional<std::vector<uint8_t>> decode_frames_until_condition(size_t current_frame_idx,
+    const std::function<bool(size_t)> &condition);
+
+  /**
+   * @brief Decodes frames from a starting index until the target frame index is reached.
+   *
+   * @param start_idx The frame index from which decoding should start.
+   * @param target_idx The target frame index to decode until.
+   * @return An optional vector of bytes containing the target frame data.
+   */
+  std::optional<std::vector<uint8_t>> decode_frames_until(size_t start_idx, size_t target_idx);
+
+  /**
+   * @brief Decodes the next available frame in sequential mode.
+   *
+   * Reads packets without seeking and decodes the first frame available. The frame is
+   * converted to the output format.
+   *
+   * @return An optional vector of bytes containing the frame data.
+   */
+  std::optional<std::vector<uint8_t>> decode_next_sequential_frame();
+
+  /**
+   * @brief Set the sequence active object.
+   *
+   * @param active
+   */
+  void set_sequence_active(bool active);
+};
+
+TSFrameExtractor::TSFrameExtractorImpl::TSFrameExtractorImpl(const std::string &filename,
+  const TSFrameExtractor::Options &options,
+  std::shared_ptr<TSFrameIndex> shared_index)
+  : m_filename(filename), m_options(options)
+{
+  spdlog::info("Creating TSFrameExtractorImpl");
+
+  // Check if the file exists using C++17 filesystem.
+  if (!std::filesystem::exists(filename)) { throw std::runtime_error("Video file not found: " + filename); }
+
+  if (m_options.follow) {
+    // A growing file can neither be mapped once nor validated against a sidecar.
+    m_options.memory_map = false;
+    m_options.index_cache = false;
+    m_options.background_indexing = true;
+  }
+
+  // Demux from a read-only mapping instead of read() calls into FFmpeg's buffers.
+  if (m_options.memory_map) {
+    try {
+      m_mapping = std::make_unique<MappedFile>(filename);
+      m_memory_data = m_mapping->data();
+      m_memory_size = m_mapping->size();
+    } catch (const std::exception &e) {
+      // Some files (network shares, special files) cannot be mapped but can still be read.
+      spdlog::warn("Failed to map {}, reading it through the file protocol instead: {}", filename, e.what());
+      m_mapping.reset();
+    }
+  }
+  initialize(std::move(shared_index));
+}
+
+TSFrameExtractor::TSFrameExtractorImpl::TSFrameExtractorImpl(const uint8_t *data,
+  size_t size,
+  const TSFrameExtractor::Options &options,
+  std::shared_ptr<TSFrameIndex> shared_index)
+  : m_options(options), m_memory_data(data), m_memory_size(size)
+{
+  spdlog::info("Creating TSFrameExtractorImpl for a {} byte buffer", size);
+  if (data == nullptr || size == 0) { throw std::invalid_argument("Video buffer is empty"); }
+
+  // There is no file to keep a sidecar next to, or to follow.
+  m_options.index_cache = false;
+  m_options.follow = false;
+  initialize(std::move(shared_index));
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::initialize(std::shared_ptr<TSFrameIndex> shared_index)
+{
+  // Open the input file/container.
+  m_container = open_container();
+
+  // Only the indexer waits for the writer of a followed file. A decode that reads past the
+  // current end is drained instead of blocking the caller until the writer catches up.
+  if ((m_container->flags & AVFMT_FLAG_CUSTOM_IO) != 0) {
+    if (auto *reader = dynamic_cast<FollowReader *>(static_cast<CustomIOSource *>(m_container->pb->opaque))) {
+      reader->setWaiting(false);
+    }
   }
 
   // Locate the first video stream.
@@ -196,38 +941,129 @@ TSFrameExtractor::TSFrameExtractorImpl::TSFrameExtractorImpl(const std::string &
   }
   if (m_stream == nullptr) {
     spdlog::error("No video streams found in file");
+    closeContainer(m_container);
     throw std::runtime_error("No video streams found in file");
   }
 
-  // Build the initial keyframe index.
-  build_keyframe_index();
+  // Allocate the packet and frame reused by the index builder and the decode loop.
+  m_packet = av_packet_alloc();
+  m_frame = av_frame_alloc();
+  if (m_packet == nullptr || m_frame == nullptr) {
+    spdlog::error("Failed to allocate packet or frame");
+    av_packet_free(&m_packet);
+    av_frame_free(&m_frame);
+    closeContainer(m_container);
+    throw std::runtime_error("Failed to allocate packet or frame");
+  }
+  ++m_stats.packet_allocations;
+  ++m_stats.frame_allocations;
+
+  if (m_container->pb != nullptr) { m_source_size = std::max<int64_t>(avio_size(m_container->pb), 0); }
+
+  if (m_options.frame_cache_bytes > 0) {
+    m_frame_cache = std::make_unique<FrameCache>(m_options.frame_cache_bytes, m_options.frame_cache_policy);
+  }
+
+  // The frame count is estimated until the index holds the exact count.
+  m_frame_count = estimate_frame_count();
+
+  // Reuse an index of the same file or the index sidecar if possible, otherwise scan the file.
+  if (shared_index != nullptr) {
+    m_index = std::move(shared_index);
+    finish_indexing(true);
+  } else if (m_options.index_cache && load_index_cache()) {
+    m_index_cached = true;
+    finish_indexing(true);
+  } else if (m_options.background_indexing) {
+    // Serve frames right away and complete the index while the caller decodes.
+    m_index_thread = std::thread(&TSFrameExtractorImpl::index_in_background, this);
+  } else {
+    build_keyframe_index();
+    finish_indexing(true);
+    if (m_options.index_cache) { save_index_cache(); }
+  }
+}
+
+AVFormatContext *TSFrameExtractor::TSFrameExtractorImpl::open_container() const
+{
+  // Demux straight from memory (a mapped file or a caller-owned buffer), or from a file
+  // that is still being written; anything else goes through FFmpeg's file protocol.
+  std::unique_ptr<CustomIOSource> source;
+  if (m_memory_data != nullptr) {
+    source = std::make_unique<MemoryReader>(m_memory_data, m_memory_size);
+  } else if (m_options.follow) {
+    source = std::make_unique<FollowReader>(m_filename, m_options.follow_options, m_stop_following);
+  }
+
+  AVFormatContext *container = nullptr;
+  AVIOContext *io = nullptr;
+  if (source != nullptr) {
+    container = avformat_alloc_context();
+    io = openCustomIO(std::move(source));
+    if (container == nullptr || io == nullptr) {
+      avformat_free_context(container);
+      freeCustomIO(io);
+      spdlog::error("Failed to allocate custom I/O context");
+      throw std::runtime_error("Failed to allocate custom I/O context");
+    }
+    container->pb = io;
+    container->flags |= AVFMT_FLAG_CUSTOM_IO;
+  }
+
+  int ret = avformat_open_input(&container, io != nullptr ? nullptr : m_filename.c_str(), nullptr, nullptr);
+  if (ret < 0) {
+    // avformat_open_input() frees the container on failure, but not a custom I/O context.
+    freeCustomIO(io);
+    std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf = {};
+    av_strerror(ret, errbuf.data(), errbuf.size());
+    spdlog::error("Failed to open video file: {}", errbuf.data());
+    throw std::runtime_error(std::string("Failed to open video file: ") + errbuf.data());
+  }
+
+  // Retrieve stream information.
+  ret = avformat_find_stream_info(container, nullptr);
+  if (ret < 0) {
+    std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf = {};
+    av_strerror(ret, errbuf.data(), errbuf.size());
+    spdlog::error("Failed to find stream info: {}", errbuf.data());
+    closeContainer(container);
+    throw std::runtime_error(std::string("Failed to find stream info: ") + errbuf.data());
+  }
+  return container;
 }
 
 TSFrameExtractor::TSFrameExtractorImpl::~TSFrameExtractorImpl()
 {
   spdlog::info("Destroying TSFrameExtractorImpl");
-  if (m_container != nullptr) { avformat_close_input(&m_container); }
+  m_stop_indexing = true;
+  m_stop_following = true;
+  if (m_index_thread.joinable()) { m_index_thread.join(); }
+  if (m_sws_context != nullptr) { sws_freeContext(m_sws_context); }
+  if (m_thumbnail_sws_context != nullptr) { sws_freeContext(m_thumbnail_sws_context); }
+  if (m_thumbnail_decoder != nullptr) { avcodec_free_context(&m_thumbnail_decoder); }
+  av_frame_free(&m_frame);
+  av_packet_free(&m_packet);
+  closeContainer(m_container);
   if (m_decoder_context != nullptr) { avcodec_free_context(&m_decoder_context); }
 }
 
 std::optional<size_t> TSFrameExtractor::TSFrameExtractorImpl::seek_to_keyframe(size_t frame_number)
 {
-  // Find the maximum key in m_keyframe_positions that is <= frame_number.
-  auto keyframe_it = m_keyframe_positions.upper_bound(frame_number);
-  if (keyframe_it == m_keyframe_positions.begin()) {
+  // Find the last keyframe at or before frame_number; the entry is a copy, so the index
+  // may keep growing while we seek.
+  const auto keyframe_info = m_index->keyframeAtOrBefore(frame_number);
+  if (!keyframe_info.has_value()) {
     spdlog::warn("No suitable keyframe found for frame {}", frame_number);
     return std::nullopt;
   }
-  --keyframe_it;// Now it points to the greatest key that is <= frame_number.
-  size_t keyframe_idx = keyframe_it->first;
-
-  // Get keyframe info using the found key.
-  const TSFrameInfo &keyframe_info = m_keyframe_positions.at(keyframe_idx);
+  const auto keyframe_idx = static_cast<size_t>(keyframe_info->frame_index);
 
   // Try to seek to the keyframe, retrying as needed.
   for (int attempt = 0; attempt < TSFrameExtractor::SEEK_RETRY_COUNT; ++attempt) {
-    int ret = av_seek_frame(m_container, m_stream->index, keyframe_info.pts, AVSEEK_FLAG_BACKWARD);
+    int ret = seek_container(keyframe_info.value());
     if (ret >= 0) {
+      // Frames still queued in the decoder belong to the old position.
+      flush_decoder();
       spdlog::info("Seek successful to keyframe at frame {}", keyframe_idx);
       return std::make_optional(keyframe_idx);// Successful seek.
     }
@@ -242,6 +1078,52 @@ std::optional<size_t> TSFrameExtractor::TSFrameExtractorImpl::seek_to_keyframe(s
   return std::nullopt;
 }
 
+int TSFrameExtractor::TSFrameExtractorImpl::seek_container(const TSFrameIndex::Keyframe &keyframe)
+{
+  ++m_stats.seeks;
+
+  // The demuxer resumes at the key packet itself; a timestamp seek in a transport stream
+  // has to search for the timestamp and may land before it.
+  const bool byte_seek = m_options.byte_seek && keyframe.position >= 0 && m_container->iformat != nullptr
+                         && std::strcmp(m_container->iformat->name, "mpegts") == 0;
+  if (byte_seek) {
+    if (const int ret = av_seek_frame(m_container, m_stream->index, keyframe.position, AVSEEK_FLAG_BYTE); ret >= 0) {
+      ++m_stats.byte_seeks;
+      return ret;
+    }
+    spdlog::debug("Byte seek to keyframe {} failed, seeking by timestamp", keyframe.frame_index);
+  }
+  return av_seek_frame(m_container, m_stream->index, keyframe.pts, AVSEEK_FLAG_BACKWARD);
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::plan_seek(size_t target,
+  const std::optional<TSFrameIndex::Keyframe> &keyframe) const
+{
+  const bool reachable = m_sequential_active && m_current_frame_index >= 0
+                         && target > static_cast<size_t>(m_current_frame_index);
+  if (!reachable) { return true; }
+  if (!keyframe.has_value() || keyframe->frame_index <= static_cast<uint64_t>(m_current_frame_index) + 1) {
+    return false;
+  }
+
+  // Decoding forward costs one decode per frame in between; a seek costs the seek itself,
+  // the refill of the frame threads and the decodes from the keyframe.
+  double seek_cost = m_options.seek_cost_frames + static_cast<double>(target - keyframe->frame_index);
+  if (m_decoder_context != nullptr && (m_decoder_context->active_thread_type & FF_THREAD_FRAME) != 0) {
+    seek_cost += m_decoder_context->thread_count;
+  }
+  const auto forward_cost = static_cast<double>(target - static_cast<size_t>(m_current_frame_index));
+  return seek_cost < forward_cost;
+}
+
+int TSFrameExtractor::TSFrameExtractorImpl::estimate_frame_count() const
+{
+  // Calculate total frame count based on stream duration and frame rate.
+  double duration_seconds = static_cast<double>(m_stream->duration) * av_q2d(m_stream->time_base);
+  double base_rate = av_q2d(m_stream->r_frame_rate);
+  return static_cast<int>(duration_seconds * base_rate);
+}
+
 void TSFrameExtractor::TSFrameExtractorImpl::build_keyframe_index()
 {
   spdlog::info("Building keyframe index");
@@ -252,45 +1134,177 @@ void TSFrameExtractor::TSFrameExtractorImpl::build_keyframe_index()
     throw std::runtime_error("Error seeking to beginning of file");
   }
 
-  int frame_idx = 0;
-  // Use the MIN_KEYFRAME_INTERVAL constant from the outer TSFrameExtractor class.
-  int last_keyframe_idx = -TSFrameExtractor::MIN_KEYFRAME_INTERVAL;
+  scan_packets(m_container, m_packet);
+
+  spdlog::info("Indexed {} keyframes in {} total frames (estimated {}), index uses {} bytes",
+    m_index->keyframeCount(),
+    m_index->frameCount(),
+    m_frame_count.value_or(0),
+    m_index->memoryUsage());
+
+  // Seek back to the beginning for sequential reading.
+  if (av_seek_frame(m_container, m_stream->index, 0, AVSEEK_FLAG_BACKWARD) < 0) {
+    spdlog::error("Error seeking back to beginning of file");
+    throw std::runtime_error("Error seeking back to beginning of file");
+  }
+}
 
-  AVPacket packet;
-  av_init_packet(&packet);
-  packet.data = nullptr;
-  packet.size = 0;
+bool TSFrameExtractor::TSFrameExtractorImpl::scan_packets(AVFormatContext *container, AVPacket *packet)
+{
+  int frame_idx = 0;
+  int64_t last_position = 0;
+
+  // A followed file is published packet by packet, so new frames are available right away.
+  const size_t batch_size = m_options.follow ? 1 : static_cast<size_t>(TSFrameExtractor::INDEX_BATCH_SIZE);
+  std::vector<TSFrameIndex::Keyframe> keyframe_batch;
+  std::vector<int64_t> pts_batch;
+  pts_batch.reserve(batch_size);
+
+  // Publish the collected entries so readers can seek into the indexed part of the file.
+  auto publish_batch = [&]() {
+    if (pts_batch.empty() && keyframe_batch.empty()) { return; }
+    m_index->append(pts_batch, keyframe_batch);
+    keyframe_batch.clear();
+    pts_batch.clear();
+    m_indexed_bytes = last_position;
+    if (m_options.follow) {
+      // Wake up waitForFrames(); taking the lock orders the notification after the append.
+      { std::lock_guard<std::mutex> lock(m_index_mutex); }
+      m_index_cv.notify_all();
+    }
+  };
 
   // Demux packets from the container.
-  while (av_read_frame(m_container, &packet) >= 0) {
-    if (packet.stream_index == m_stream->index) {
-      // Check for keyframe using the FFmpeg flag and interval.
-      if ((packet.flags & AV_PKT_FLAG_KEY)
-          && (frame_idx - last_keyframe_idx >= TSFrameExtractor::MIN_KEYFRAME_INTERVAL)) {
-        m_keyframe_positions.emplace(frame_idx, TSFrameInfo{ packet.pts, packet.dts, true, packet.pos });
-        last_keyframe_idx = frame_idx;
+  while (!m_stop_indexing && av_read_frame(container, packet) >= 0) {
+    if (packet->stream_index == m_stream->index) {
+      // Keep every keyframe: the closer the keyframe before a frame, the less random
+      // access has to decode.
+      if ((packet->flags & AV_PKT_FLAG_KEY) != 0) {
+        keyframe_batch.push_back({ static_cast<uint64_t>(frame_idx), packet->pts, packet->dts, packet->pos });
       }
-      // Map packet pts to frame index if pts is valid.
-      if (packet.pts != AV_NOPTS_VALUE) {
-        m_frame_indices[packet.pts] = frame_idx;
+      // Every packet with a valid pts is one frame; its rank in pts order is its index.
+      if (packet->pts != AV_NOPTS_VALUE) {
+        pts_batch.push_back(packet->pts);
         ++frame_idx;
       }
     }
-    av_packet_unref(&packet);
+    if (packet->pos >= 0) { last_position = packet->pos; }
+    av_packet_unref(packet);
+
+    if (pts_batch.size() >= batch_size) { publish_batch(); }
   }
+  publish_batch();
 
-  // Calculate total frame count based on stream duration and frame rate.
-  double duration_seconds = m_stream->duration * av_q2d(m_stream->time_base);
-  double base_rate = av_q2d(m_stream->r_frame_rate);
-  m_frame_count = static_cast<int>(duration_seconds * base_rate);
+  return !m_stop_indexing;
+}
 
-  spdlog::info("Indexed {} keyframes in {} total frames", m_keyframe_positions.size(), m_frame_count.value());
+void TSFrameExtractor::TSFrameExtractorImpl::index_in_background()
+{
+  spdlog::info("Building keyframe index in the background");
 
-  // Seek back to the beginning for sequential reading.
-  if (av_seek_frame(m_container, m_stream->index, 0, AVSEEK_FLAG_BACKWARD) < 0) {
-    spdlog::error("Error seeking back to beginning of file");
-    throw std::runtime_error("Error seeking back to beginning of file");
+  // The decode path owns m_container, so the indexer demuxes the file on its own.
+  AVFormatContext *container = nullptr;
+  AVPacket *packet = nullptr;
+  bool complete = false;
+  try {
+    container = open_container();
+    packet = av_packet_alloc();
+    if (packet == nullptr) { throw std::runtime_error("Failed to allocate packet"); }
+    complete = scan_packets(container, packet);
+  } catch (const std::exception &e) {
+    spdlog::error("Background indexing failed: {}", e.what());
   }
+  av_packet_free(&packet);
+  closeContainer(container);
+
+  if (complete) {
+    spdlog::info(
+      "Indexed {} keyframes in {} total frames in the background", m_index->keyframeCount(), m_index->frameCount());
+    if (m_options.index_cache) { save_index_cache(); }
+  }
+  finish_indexing(complete);
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::finish_indexing(bool complete)
+{
+  if (complete) { m_index->shrinkToFit(); }
+  {
+    std::lock_guard<std::mutex> lock(m_index_mutex);
+    m_index_complete = complete;
+    m_indexing_done = true;
+  }
+  m_index_cv.notify_all();
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::index_covers(size_t frame_number) const
+{
+  if (m_index_complete) { return true; }
+
+  // A followed file has no later estimate to fall back on: every indexed frame is decoded
+  // from its keyframe, waiting for the writer if the decoder needs packets past the end.
+  if (m_options.follow) { return frame_number < m_index->frameCount(); }
+
+  // The GOP of the frame is known once a later keyframe has been indexed.
+  return m_index->hasKeyframeAfter(frame_number);
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_by_timestamp(size_t frame_number)
+{
+  const double frame_rate = av_q2d(m_stream->r_frame_rate);
+  const double time_base = av_q2d(m_stream->time_base);
+  if (frame_rate <= 0 || time_base <= 0) {
+    spdlog::error("Cannot seek by timestamp without a valid frame rate");
+    return std::nullopt;
+  }
+  const int64_t start_time = m_stream->start_time == AV_NOPTS_VALUE ? 0 : m_stream->start_time;
+  const auto target_pts =
+    start_time + static_cast<int64_t>(std::llround(static_cast<double>(frame_number) / frame_rate / time_base));
+
+  spdlog::info("Frame {} is not indexed yet, seeking by timestamp {}", frame_number, target_pts);
+  if (av_seek_frame(m_container, m_stream->index, target_pts, AVSEEK_FLAG_BACKWARD) < 0) {
+    spdlog::error("Timestamp seek failed for frame {}", frame_number);
+    return std::nullopt;
+  }
+  flush_decoder();
+
+  // Decode until the timestamp of a frame maps to the requested frame number.
+  while (!cancelled() && receive_next_frame()) {
+    int64_t pts = m_frame->best_effort_timestamp;
+    if (pts == AV_NOPTS_VALUE) { pts = m_frame->pts; }
+    if (pts == AV_NOPTS_VALUE) { continue; }
+
+    const auto frame_idx = std::llround(static_cast<double>(pts - start_time) * time_base * frame_rate);
+    if (frame_idx >= static_cast<long long>(frame_number)) { return convert_frame(); }
+  }
+
+  if (!cancelled()) { spdlog::warn("Frame {} not found after timestamp seek", frame_number); }
+  return std::nullopt;
+}
+
+std::string TSFrameExtractor::TSFrameExtractorImpl::index_cache_path() const
+{
+  return m_options.index_cache_path.empty() ? m_filename + ".idx" : m_options.index_cache_path;
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::load_index_cache()
+{
+  const auto stamp = sourceFileStamp(m_filename);
+  if (!stamp.has_value()) { return false; }
+
+  const std::string path = index_cache_path();
+  if (!m_index->load(path, stamp->first, stamp->second)) { return false; }
+
+  spdlog::info("Loaded {} keyframes in {} total frames from {}", m_index->keyframeCount(), m_index->frameCount(), path);
+  return true;
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::save_index_cache() const
+{
+  const auto stamp = sourceFileStamp(m_filename);
+  if (!stamp.has_value()) { return; }
+
+  const std::string path = index_cache_path();
+  if (m_index->save(path, stamp->first, stamp->second)) { spdlog::info("Saved index cache: {}", path); }
 }
 
 std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getFrame(size_t frame_number)
@@ -301,6 +1315,53 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getF
     throw std::out_of_range("Frame number " + std::to_string(frame_number) + " out of range");
   }
 
+  // Stepping back by one frame switches to the reverse playback buffer; anything else,
+  // including a backward jump, releases it.
+  m_playing_backward = m_options.reverse_buffer_bytes > 0 && m_last_requested.has_value()
+                       && frame_number + 1 == m_last_requested.value();
+  if (!m_playing_backward) { release_reverse_frames(); }
+  m_last_requested = frame_number;
+
+  auto frame_data = decode_frame(frame_number);
+  if (frame_data.has_value()) { ++m_stats.frames_returned; }
+  return frame_data;
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getFrame(size_t frame_number,
+  const std::atomic<bool> &cancel)
+{
+  if (cancel) {
+    ++m_stats.frames_cancelled;
+    return std::nullopt;
+  }
+
+  // The decode loops poll the flag while this request is running.
+  m_cancel = &cancel;
+  std::optional<std::vector<uint8_t>> frame_data;
+  try {
+    frame_data = getFrame(frame_number);
+  } catch (...) {
+    m_cancel = nullptr;
+    throw;
+  }
+  m_cancel = nullptr;
+
+  if (cancel) {
+    // The decoder stopped somewhere inside the GOP; a later frame has to seek again.
+    set_sequence_active(false);
+    if (frame_data.has_value()) {
+      recycleFrame(std::move(frame_data.value()));
+      --m_stats.frames_returned;
+    }
+    ++m_stats.frames_cancelled;
+    spdlog::debug("Request for frame {} cancelled", frame_number);
+    return std::nullopt;
+  }
+  return frame_data;
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_frame(size_t frame_number)
+{
   // --- Sequential Access ---
   if (frame_number == static_cast<size_t>(m_current_frame_index + 1) && m_sequential_active) {
     if (auto nextFrame = decode_next_sequential_frame(); nextFrame.has_value()) {
@@ -309,33 +1370,20 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getF
     }
     // If decoding failed, disable sequential mode.
     set_sequence_active(false);
+    if (cancelled()) { return std::nullopt; }
   }
 
-  // Ensure m_decoder_context is valid.
-  if (m_decoder_context == nullptr) {
-    const AVCodec *codec = avcodec_find_decoder(m_stream->codecpar->codec_id);
-    if (codec == nullptr) {
-      spdlog::error("Decoder not found for codec id");
-      throw std::runtime_error("Decoder not found for codec id");
-    }
-
-    m_decoder_context = avcodec_alloc_context3(codec);
-    if (m_decoder_context == nullptr) {
-      spdlog::error("Failed to allocate decoder context");
-      throw std::runtime_error("Failed to allocate decoder context");
-    }
+  // --- Decoded Frame Cache ---
+  // A hit leaves the decoder where it is, so sequential reading can still continue.
+  if (auto cached = lookup_cached_frame(frame_number); cached.has_value()) { return cached; }
 
-    if (avcodec_parameters_to_context(m_decoder_context, m_stream->codecpar) < 0) {
-      spdlog::error("Failed to copy codec parameters to decoder context");
-      avcodec_free_context(&m_decoder_context);
-      throw std::runtime_error("Failed to copy codec parameters to decoder context");
-    }
+  // Ensure m_decoder_context is valid.
+  open_decoder();
 
-    if (avcodec_open2(m_decoder_context, codec, nullptr) < 0) {
-      spdlog::error("Failed to open decoder");
-      avcodec_free_context(&m_decoder_context);
-      throw std::runtime_error("Failed to open decoder");
-    }
+  // --- Reverse Playback ---
+  if (m_playing_backward) {
+    if (auto frame_data = decode_reverse(frame_number); frame_data.has_value()) { return frame_data; }
+    if (cancelled()) { return std::nullopt; }
   }
 
   // --- Handle Frame 0 Specially ---
@@ -347,7 +1395,7 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getF
     }
 
     // Flush the decoder buffers to ensure a clean start.
-    avcodec_flush_buffers(m_decoder_context);
+    flush_decoder();
     set_sequence_active(true);
     m_current_frame_index = -1;
     if (auto firstFrame = decode_next_sequential_frame(); firstFrame.has_value()) {
@@ -361,13 +1409,36 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getF
   }
 
   // --- Random Access ---
+  if (!index_covers(frame_number)) {
+    // Indexing has not reached this frame yet: fall back to a timestamp seek.
+    auto frame_data = decode_by_timestamp(frame_number);
+    set_sequence_active(false);
+    return frame_data;
+  }
+
+  // A frame a little ahead of the decoder is cheaper to reach by decoding forward.
+  if (!plan_seek(frame_number, m_index->keyframeAtOrBefore(frame_number))) {
+    auto frame_data = decode_frames_until(static_cast<size_t>(m_current_frame_index + 1), frame_number);
+    if (frame_data.has_value()) {
+      m_current_frame_index = static_cast<int>(frame_number);
+      return frame_data;
+    }
+    set_sequence_active(false);
+    if (cancelled()) { return std::nullopt; }
+  }
+
   try {
     // Seek to the nearest previous keyframe.
     if (auto keyframe_opt = seek_to_keyframe(frame_number); keyframe_opt.has_value()) {
       // Decode frames from that keyframe until the requested frame is reached.
       auto frame_data = decode_frames_until(keyframe_opt.value(), frame_number);
-      // Random access resets sequential state.
-      set_sequence_active(false);
+      // The decoder stops right after the requested frame, so the next one follows without a seek.
+      if (frame_data.has_value()) {
+        m_current_frame_index = static_cast<int>(frame_number);
+        set_sequence_active(true);
+      } else {
+        set_sequence_active(false);
+      }
       return frame_data;
     }
     return std::nullopt;
@@ -377,138 +1448,393 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::getF
   }
 }
 
-std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_frames_until_condition(
-  size_t current_frame_idx,
-  const std::function<bool(size_t)> &condition)
+AVCodecContext *TSFrameExtractor::TSFrameExtractorImpl::allocate_decoder() const
 {
-  // Allocate an AVPacket for reading compressed data.
-  AVPacket *packet = av_packet_alloc();
-  if (packet == nullptr) {
-    spdlog::error("Failed to allocate packet");
-    return std::nullopt;
+  const AVCodec *codec = avcodec_find_decoder(m_stream->codecpar->codec_id);
+  if (codec == nullptr) {
+    spdlog::error("Decoder not found for codec id");
+    throw std::runtime_error("Decoder not found for codec id");
   }
 
-  // Allocate an AVFrame for decoding raw frames.
-  AVFrame *frame = av_frame_alloc();
-  if (frame == nullptr) {
-    spdlog::error("Failed to allocate frame");
-    av_packet_free(&packet);
-    return std::nullopt;
+  AVCodecContext *context = avcodec_alloc_context3(codec);
+  if (context == nullptr) {
+    spdlog::error("Failed to allocate decoder context");
+    throw std::runtime_error("Failed to allocate decoder context");
   }
 
-  bool target_frame_found = false;// Flag to indicate if target frame is reached.
-  std::optional<std::vector<uint8_t>> result = std::nullopt;// Optional result for the frame data.
+  if (avcodec_parameters_to_context(context, m_stream->codecpar) < 0) {
+    spdlog::error("Failed to copy codec parameters to decoder context");
+    avcodec_free_context(&context);
+    throw std::runtime_error("Failed to copy codec parameters to decoder context");
+  }
+  return context;
+}
 
-  // Loop over packets from the container.
-  while (av_read_frame(m_container, packet) >= 0) {
-    // Process only packets belonging to the video stream.
-    if (packet->stream_index != m_stream->index) {
-      av_packet_unref(packet);// Unreference packets not belonging to our stream.
-      continue;
-    }
+void TSFrameExtractor::TSFrameExtractorImpl::open_thumbnail_decoder()
+{
+  if (m_thumbnail_decoder != nullptr) { return; }
+
+  m_thumbnail_decoder = allocate_decoder();
+  // Only intra frames are decoded, one at a time, so threading would only add latency.
+  m_thumbnail_decoder->skip_frame = AVDISCARD_NONKEY;
+  m_thumbnail_decoder->thread_count = 1;
+  if (avcodec_open2(m_thumbnail_decoder, m_thumbnail_decoder->codec, nullptr) < 0) {
+    spdlog::error("Failed to open thumbnail decoder");
+    avcodec_free_context(&m_thumbnail_decoder);
+    throw std::runtime_error("Failed to open thumbnail decoder");
+  }
+}
 
-    // Send the packet to the decoder.
-    int ret = avcodec_send_packet(m_decoder_context, packet);
-    if (ret < 0) {
-      std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf{};
-      av_strerror(ret, errbuf.data(), errbuf.size());
-      spdlog::error("Error sending packet to decoder: {}", errbuf.data());
-      break;
-    }
+void TSFrameExtractor::TSFrameExtractorImpl::open_decoder()
+{
+  if (m_decoder_context != nullptr) { return; }
+
+  m_decoder_context = allocate_decoder();
+  const AVCodec *codec = m_decoder_context->codec;
+
+  // Configure threading before opening; FFmpeg ignores thread types the codec lacks.
+  int thread_type = 0;
+  if (m_options.frame_threading) { thread_type |= FF_THREAD_FRAME; }
+  if (m_options.slice_threading) { thread_type |= FF_THREAD_SLICE; }
+  m_decoder_context->thread_type = thread_type;
+  m_decoder_context->thread_count = thread_type == 0 ? 1 : std::max(0, m_options.decoder_threads);
+  m_decoder_context->lowres = select_lowres(codec->max_lowres);
+
+  if (avcodec_open2(m_decoder_context, codec, nullptr) < 0) {
+    spdlog::error("Failed to open decoder");
+    avcodec_free_context(&m_decoder_context);
+    throw std::runtime_error("Failed to open decoder");
+  }
+  m_decoder_draining = false;
+
+  spdlog::info("Opened {} decoder with {} threads (frame threading: {}, slice threading: {}, lowres: {})",
+    codec->name,
+    m_decoder_context->thread_count,
+    (m_decoder_context->active_thread_type & FF_THREAD_FRAME) != 0,
+    (m_decoder_context->active_thread_type & FF_THREAD_SLICE) != 0,
+    m_decoder_context->lowres);
+}
 
-    // Process all available decoded frames.
-    while (true) {
-      ret = avcodec_receive_frame(m_decoder_context, frame);
-      if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-        spdlog::warn("[TSFrameExtractorImpl] Decoder returned EAGAIN or EOF");
-        break;
-      } else if (ret < 0) {
+int TSFrameExtractor::TSFrameExtractorImpl::select_lowres(int max_lowres) const
+{
+  const FrameSize &requested = m_options.output_size;
+  if (!m_options.decoder_lowres || (requested.width == 0 && requested.height == 0)) { return 0; }
+
+  const int width = m_stream->codecpar->width;
+  const int height = m_stream->codecpar->height;
+  if (width <= 0 || height <= 0) { return 0; }
+  const auto [out_width, out_height] = resolveOutputSize(requested, width, height);
+
+  // Each lowres step halves both dimensions; stop before the frame gets smaller than the output.
+  int lowres = 0;
+  while (lowres < max_lowres && (width >> (lowres + 1)) >= out_width && (height >> (lowres + 1)) >= out_height) {
+    ++lowres;
+  }
+  return lowres;
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::flush_decoder()
+{
+  if (m_decoder_context == nullptr) { return; }
+  avcodec_flush_buffers(m_decoder_context);
+  m_decoder_draining = false;
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::receive_next_frame()
+{
+  while (true) {
+    // Drain frames the decoder has already produced before feeding it more data.
+    int ret = avcodec_receive_frame(m_decoder_context, m_frame);
+    if (ret == 0) {
+      ++m_stats.frames_decoded;
+      return true;
+    }
+    if (ret != AVERROR(EAGAIN)) {
+      if (ret != AVERROR_EOF) {
         std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf{};
         av_strerror(ret, errbuf.data(), errbuf.size());
         spdlog::error("Error receiving frame from decoder: {}", errbuf.data());
-        break;
       }
+      return false;
+    }
+
+    // Once draining, the decoder returns its buffered frames followed by AVERROR_EOF.
+    if (m_decoder_draining) { return false; }
 
-      // Increment the frame counter for every successfully decoded frame.
-      current_frame_idx++;
-
-      // If the condition is not met for the current frame - continue.
-      if (!condition(current_frame_idx)) { continue; }
-
-      // Condition met: prepare to convert the frame.
-      // Create a scaling context to convert the frame to BGR24.
-      SwsContext *sws_ctx = sws_getContext(frame->width,
-        frame->height,
-        static_cast<AVPixelFormat>(frame->format),
-        frame->width,
-        frame->height,
-        AV_PIX_FMT_BGR24,
-        SWS_BILINEAR,
-        nullptr,
-        nullptr,
-        nullptr);
-      if (sws_ctx == nullptr) {
-        spdlog::error("Failed to create sws context for conversion");
+    // The decoder needs more input: read the next packet of the video stream.
+    bool packet_read = false;
+    while (av_read_frame(m_container, m_packet) >= 0) {
+      if (m_packet->stream_index == m_stream->index) {
+        packet_read = true;
         break;
       }
+      av_packet_unref(m_packet);// Unreference packets not belonging to our stream.
+    }
 
-      // Determine the required buffer size for the BGR24 converted image.
-      int num_bytes = av_image_get_buffer_size(AV_PIX_FMT_BGR24, frame->width, frame->height, 1);
-      std::vector<uint8_t> buffer(num_bytes);// Allocate the output buffer.
+    if (packet_read) {
+      // Send the packet to the decoder.
+      ret = avcodec_send_packet(m_decoder_context, m_packet);
+      av_packet_unref(m_packet);
+    } else {
+      // End of file: signal end of stream so the decoder releases the frames it holds back.
+      ret = avcodec_send_packet(m_decoder_context, nullptr);
+      m_decoder_draining = true;
+    }
+    if (ret < 0) {
+      std::array<char, AV_ERROR_MAX_STRING_SIZE> errbuf{};
+      av_strerror(ret, errbuf.data(), errbuf.size());
+      spdlog::error("Error sending packet to decoder: {}", errbuf.data());
+      return false;
+    }
+  }
+}
 
-      // Setup destination pointers and linesizes for the conversion.
-      uint8_t *dest_data[4] = { buffer.data(), nullptr, nullptr, nullptr };
-      int dest_linesize[4] = { frame->width * 3, 0, 0, 0 };
+std::vector<uint8_t> TSFrameExtractor::TSFrameExtractorImpl::acquire_buffer(size_t size)
+{
+  if (m_buffer_pool.empty()) {
+    ++m_stats.buffer_allocations;
+    return std::vector<uint8_t>(size);
+  }
 
-      // Perform the conversion using sws_scale.
-      int converted_height =
-        sws_scale(sws_ctx, frame->data, frame->linesize, 0, frame->height, dest_data, dest_linesize);
-      sws_freeContext(sws_ctx);// Free the scaling context.
+  std::vector<uint8_t> buffer = std::move(m_buffer_pool.back());
+  m_buffer_pool.pop_back();
+  // Resizing within the existing capacity does not allocate.
+  if (buffer.capacity() < size) { ++m_stats.buffer_allocations; }
+  buffer.resize(size);
+  return buffer;
+}
 
-      // Check if the full frame was converted.
-      if (converted_height != frame->height) {
-        spdlog::error(
-          "Frame conversion incomplete: converted height {} != frame height {}", converted_height, frame->height);
-        break;
-      }
+void TSFrameExtractor::TSFrameExtractorImpl::recycleFrame(std::vector<uint8_t> &&buffer)
+{
+  if (buffer.capacity() == 0 || m_buffer_pool.size() >= TSFrameExtractor::BUFFER_POOL_SIZE) {
+    buffer = std::vector<uint8_t>{};
+    return;
+  }
+  m_buffer_pool.push_back(std::move(buffer));
+  buffer = std::vector<uint8_t>{};
+}
 
-      // Save the converted buffer as the result.
-      result = std::move(buffer);
-      target_frame_found = true;
+bool TSFrameExtractor::TSFrameExtractorImpl::scale_frame(SwsContext *&context,
+  int width,
+  int height,
+  std::vector<uint8_t> &buffer)
+{
+  const AVPixelFormat output_format = toAVPixelFormat(m_options.output_format);
+
+  // Reuse the scaling context as long as the source and output geometry do not change.
+  SwsContext *sws_ctx = sws_getCachedContext(context,
+    m_frame->width,
+    m_frame->height,
+    static_cast<AVPixelFormat>(m_frame->format),
+    width,
+    height,
+    output_format,
+    width == m_frame->width && height == m_frame->height ? SWS_BILINEAR : SWS_AREA,
+    nullptr,
+    nullptr,
+    nullptr);
+  if (sws_ctx == nullptr) {
+    spdlog::error("Failed to create sws context for conversion");
+    context = nullptr;
+    return false;
+  }
+  if (sws_ctx != context) { ++m_stats.scaler_allocations; }
+  context = sws_ctx;
 
-      // Set frame size
-      if (!m_frame_size.has_value()) {
-        spdlog::info("Setting frame size to {}x{}", frame->height, frame->width);
-        m_frame_size = FrameSize{ static_cast<size_t>(frame->height), static_cast<size_t>(frame->width) };
-      }
+  // Setup destination pointers and linesizes for the (possibly planar) output.
+  uint8_t *dest_data[4] = { nullptr, nullptr, nullptr, nullptr };
+  int dest_linesize[4] = { 0, 0, 0, 0 };
+  av_image_fill_arrays(dest_data, dest_linesize, buffer.data(), output_format, width, height, 1);
+
+  // Perform the conversion using sws_scale.
+  int converted_height = sws_scale(context, m_frame->data, m_frame->linesize, 0, m_frame->height, dest_data, dest_linesize);
 
-      break;// Exit the inner loop as the target frame has been found.
+  // Check if the full frame was converted.
+  if (converted_height != height) {
+    spdlog::error("Frame conversion incomplete: converted height {} != output height {}", converted_height, height);
+    return false;
+  }
+  return true;
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::convert_frame()
+{
+  const AVPixelFormat output_format = toAVPixelFormat(m_options.output_format);
+  const auto source_format = static_cast<AVPixelFormat>(m_frame->format);
+  const auto [width, height] = resolveOutputSize(m_options.output_size, m_frame->width, m_frame->height);
+  const bool resized = width != m_frame->width || height != m_frame->height;
+
+  // Determine the required buffer size for the converted image.
+  int num_bytes = av_image_get_buffer_size(output_format, width, height, 1);
+  if (num_bytes < 0) {
+    spdlog::error("Failed to compute output buffer size for {}x{}", width, height);
+    return std::nullopt;
+  }
+  std::vector<uint8_t> buffer = acquire_buffer(static_cast<size_t>(num_bytes));
+
+  bool converted = true;
+  if (resized) {
+    // Downscale during the format conversion; no full-size intermediate is produced.
+    converted = scale_frame(m_sws_context, width, height, buffer);
+  } else if (source_format == output_format) {
+    // The decoder already produces the requested layout: pack the planes.
+    av_image_copy_to_buffer(buffer.data(), num_bytes, m_frame->data, m_frame->linesize, output_format, width, height, 1);
+  } else if (m_options.output_format == PixelFormat::GRAY8 && hasFullRangeLuma8(m_frame)) {
+    // Full-range luma is the gray image: copy plane 0.
+    av_image_copy_plane(buffer.data(), width, m_frame->data[0], m_frame->linesize[0], width, height);
+  } else if (m_options.output_format == PixelFormat::GRAY16 && hasFullRangeLuma8(m_frame)) {
+    // Widen full-range luma to 16 bits in one pass; v * 257 matches swscale's expansion.
+    auto *dest = reinterpret_cast<uint16_t *>(buffer.data());
+    for (int y = 0; y < height; ++y) {
+      const uint8_t *src_row = m_frame->data[0] + static_cast<ptrdiff_t>(y) * m_frame->linesize[0];
+      uint16_t *dest_row = dest + static_cast<ptrdiff_t>(y) * width;
+      for (int x = 0; x < width; ++x) { dest_row[x] = static_cast<uint16_t>(src_row[x] * 257); }
     }
+  } else {
+    converted = scale_frame(m_sws_context, width, height, buffer);
+  }
 
-    // Unreference the packet after processing.
-    av_packet_unref(packet);
+  if (!converted) {
+    recycleFrame(std::move(buffer));
+    return std::nullopt;
+  }
 
-    // If target frame has been found, exit the loop.
-    if (target_frame_found) {
-      spdlog::info("Target frame {} found", current_frame_idx);
-      break;
+  // Set frame size
+  if (!m_frame_size.has_value()) {
+    spdlog::info("Setting frame size to {}x{}", height, width);
+    m_frame_size = FrameSize{ static_cast<size_t>(height), static_cast<size_t>(width) };
+  }
+
+  return buffer;
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_reverse(size_t frame_number)
+{
+  // Serve the frame if it is buffered; frames after it are not needed any more.
+  if (!m_reverse_frames.empty() && frame_number >= m_reverse_first
+      && frame_number < m_reverse_first + m_reverse_frames.size()) {
+    while (m_reverse_first + m_reverse_frames.size() > frame_number + 1) {
+      recycleFrame(std::move(m_reverse_frames.back()));
+      m_reverse_frames.pop_back();
+    }
+    std::vector<uint8_t> frame_data = std::move(m_reverse_frames.back());
+    m_reverse_frames.pop_back();
+    return frame_data;
+  }
+  release_reverse_frames();
+
+  // The output size is known once a frame has been converted.
+  if (!m_frame_size.has_value() || !index_covers(frame_number)) { return std::nullopt; }
+  const size_t frame_bytes = frameBufferSize(m_options.output_format, m_frame_size.value());
+  const size_t max_frames = std::max<size_t>(1, m_options.reverse_buffer_bytes / std::max<size_t>(1, frame_bytes));
+
+  const auto keyframe = m_index->keyframeAtOrBefore(frame_number);
+  if (!keyframe.has_value()) { return std::nullopt; }
+  const auto keyframe_idx = static_cast<size_t>(keyframe->frame_index);
+
+  // Keep the frames closest to the request; a GOP larger than the buffer is refilled in
+  // chunks of max_frames, which still decodes it far fewer times than once per frame.
+  const size_t first_kept = frame_number + 1 - std::min(max_frames, frame_number + 1 - keyframe_idx);
+  if (!seek_to_keyframe(frame_number).has_value()) { return std::nullopt; }
+  set_sequence_active(false);
+
+  m_reverse_frames.reserve(frame_number + 1 - first_kept);
+  for (size_t frame_idx = keyframe_idx; frame_idx <= frame_number; ++frame_idx) {
+    if (cancelled()) {
+      release_reverse_frames();
+      return std::nullopt;
+    }
+    if (!receive_next_frame()) {
+      spdlog::warn("Reverse playback stopped decoding at frame {}", frame_idx);
+      release_reverse_frames();
+      return std::nullopt;
+    }
+    if (frame_idx < first_kept) { continue; }
+    auto frame_data = convert_frame();
+    if (!frame_data.has_value()) {
+      release_reverse_frames();
+      return std::nullopt;
     }
+    m_reverse_frames.push_back(std::move(frame_data.value()));
   }
+  m_reverse_first = first_kept;
+  spdlog::debug("Buffered frames {} to {} for reverse playback", first_kept, frame_number);
 
-  // Free the allocated frame and packet.
-  av_frame_free(&frame);
-  av_packet_free(&packet);
+  // The decoder stopped right after the requested frame, so playing forward again from
+  // there continues without a seek.
+  m_current_frame_index = static_cast<int>(frame_number);
+  set_sequence_active(true);
 
-  if (!target_frame_found) { spdlog::warn("Target frame condition was not met during decoding"); }
-  return result;
+  std::vector<uint8_t> frame_data = std::move(m_reverse_frames.back());
+  m_reverse_frames.pop_back();
+  return frame_data;
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::release_reverse_frames()
+{
+  for (auto &frame_data : m_reverse_frames) { recycleFrame(std::move(frame_data)); }
+  m_reverse_frames.clear();
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::lookup_cached_frame(size_t frame_number)
+{
+  if (m_frame_cache == nullptr) { return std::nullopt; }
+  const std::vector<uint8_t> *cached = m_frame_cache->lookup(frame_number);
+  if (cached == nullptr) { return std::nullopt; }
+
+  std::vector<uint8_t> buffer = acquire_buffer(cached->size());
+  std::copy(cached->begin(), cached->end(), buffer.begin());
+  spdlog::debug("Frame {} served from the frame cache", frame_number);
+  return buffer;
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::cache_decoded_frame(size_t frame_number)
+{
+  if (m_frame_cache == nullptr || m_frame_cache->contains(frame_number)) { return; }
+  if (auto buffer = convert_frame(); buffer.has_value()) {
+    m_frame_cache->insert(frame_number, buffer->data(), buffer->size());
+    recycleFrame(std::move(buffer.value()));
+  }
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_frames_until_condition(
+  size_t current_frame_idx,
+  const std::function<bool(size_t)> &condition)
+{
+  // Decode frames with the packet and frame owned by the extractor; nothing is allocated
+  // here once the scaler context and the buffer pool are warmed up.
+  while (receive_next_frame()) {
+    // Increment the frame counter for every successfully decoded frame.
+    current_frame_idx++;
+
+    // A cancelled request stops here, mid-GOP, instead of decoding up to its target.
+    if (cancelled()) { return std::nullopt; }
+
+    // If the condition is not met for the current frame - keep it for stepping back and continue.
+    if (!condition(current_frame_idx)) {
+      cache_decoded_frame(current_frame_idx);
+      continue;
+    }
+
+    // Condition met: convert the frame to the output format.
+    auto result = convert_frame();
+    if (result.has_value()) {
+      spdlog::debug("Target frame {} found", current_frame_idx);
+      if (m_frame_cache != nullptr) { m_frame_cache->insert(current_frame_idx, result->data(), result->size()); }
+    }
+    return result;
+  }
+
+  if (!cancelled()) { spdlog::warn("Target frame condition was not met during decoding"); }
+  return std::nullopt;
 }
 
 // Random access: decode frames from a given start index until target_idx is reached.
 std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::decode_frames_until(size_t start_idx,
   size_t target_idx)
 {
-  int local_frame_idx = start_idx - 1;
-  auto condition = [target_idx](int frame_idx) { return frame_idx == target_idx; };
+  size_t local_frame_idx = start_idx - 1;
+  auto condition = [target_idx](size_t frame_idx) { return frame_idx == target_idx; };
   return decode_frames_until_condition(local_frame_idx, condition);
 }
 
@@ -518,18 +1844,159 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::TSFrameExtractorImpl::deco
   int local_frame_idx = m_current_frame_index;// m_currentFrameIdx is a member tracking
                                               // the last decoded frame.
   // For sequential access, we simply accept the first decoded frame.
-  auto condition = [](int /*frame_idx*/) { return true; };
-  auto result = decode_frames_until_condition(local_frame_idx, condition);
+  auto condition = [](size_t /*frame_idx*/) { return true; };
+  auto result = decode_frames_until_condition(static_cast<size_t>(local_frame_idx), condition);
   // Update the persistent sequential frame index.
   if (result.has_value()) {
-    spdlog::info("Decoded frame {}", local_frame_idx);
+    spdlog::debug("Decoded frame {}", local_frame_idx);
     m_current_frame_index = local_frame_idx;
-  } else {
+  } else if (!cancelled()) {
     spdlog::error("[decode_next_sequential_frame] Error decoding frame {}", local_frame_idx);
   }
   return result;
 }
 
+void TSFrameExtractor::TSFrameExtractorImpl::getFrames(const std::vector<size_t> &frame_numbers,
+  const TSFrameExtractor::FrameCallback &callback)
+{
+  std::vector<size_t> targets(frame_numbers);
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  if (targets.empty()) { return; }
+
+  const auto total_frames = getTotalFrames();
+  if (targets.back() >= total_frames) {
+    throw std::out_of_range("Frame number " + std::to_string(targets.back()) + " out of range");
+  }
+
+  open_decoder();
+  release_reverse_frames();
+  m_playing_backward = false;
+
+  for (const size_t target : targets) {
+    m_last_requested = target;
+    if (auto cached = lookup_cached_frame(target); cached.has_value()) {
+      ++m_stats.frames_returned;
+      callback(target, std::move(cached.value()));
+      continue;
+    }
+
+    // Decode forward from the current position unless seeking to a later keyframe is
+    // estimated to be cheaper.
+    const auto keyframe = index_covers(target) ? m_index->keyframeAtOrBefore(target) : std::nullopt;
+    if (plan_seek(target, keyframe)) {
+      if (!keyframe.has_value()) {
+        // Not indexed yet or no keyframe before the frame: use the single frame path.
+        set_sequence_active(false);
+        if (auto frame_data = decode_frame(target); frame_data.has_value()) {
+          ++m_stats.frames_returned;
+          callback(target, std::move(frame_data.value()));
+        }
+        continue;
+      }
+      try {
+        if (!seek_to_keyframe(target).has_value()) { continue; }
+      } catch (const std::exception &e) {
+        spdlog::error("Error seeking to frame {}: {}", target, e.what());
+        set_sequence_active(false);
+        continue;
+      }
+      m_current_frame_index = static_cast<int>(keyframe->frame_index) - 1;
+    }
+
+    // The decoder now sits in front of the target: continue from there like sequential reads.
+    set_sequence_active(true);
+    auto frame_data = decode_frames_until(static_cast<size_t>(m_current_frame_index + 1), target);
+    if (!frame_data.has_value()) {
+      spdlog::warn("Failed to decode frame {} of batch", target);
+      set_sequence_active(false);
+      continue;
+    }
+    m_current_frame_index = static_cast<int>(target);
+    ++m_stats.frames_returned;
+    callback(target, std::move(frame_data.value()));
+  }
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::getKeyframeThumbnails(const std::vector<size_t> &frame_numbers,
+  FrameSize size,
+  const TSFrameExtractor::FrameCallback &callback)
+{
+  // Each requested frame is represented by the keyframe of its GOP.
+  std::vector<TSFrameIndex::Keyframe> keyframes;
+  keyframes.reserve(frame_numbers.size());
+  for (const size_t frame_number : frame_numbers) {
+    if (auto keyframe = m_index->keyframeAtOrBefore(frame_number); keyframe.has_value()) {
+      keyframes.push_back(keyframe.value());
+    }
+  }
+  std::sort(keyframes.begin(), keyframes.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.frame_index < rhs.frame_index;
+  });
+  keyframes.erase(std::unique(keyframes.begin(),
+                    keyframes.end(),
+                    [](const auto &lhs, const auto &rhs) { return lhs.frame_index == rhs.frame_index; }),
+    keyframes.end());
+  if (keyframes.empty()) { return; }
+
+  // The thumbnails share the demuxer with the decode path, which has to seek afterwards.
+  open_decoder();
+  open_thumbnail_decoder();
+  set_sequence_active(false);
+  release_reverse_frames();
+  m_last_requested.reset();
+
+  for (const auto &keyframe : keyframes) {
+    if (seek_container(keyframe) < 0) {
+      spdlog::warn("Failed to seek to keyframe {}", keyframe.frame_index);
+      continue;
+    }
+    flush_decoder();
+    if (!decode_keyframe(keyframe)) {
+      spdlog::warn("Failed to decode keyframe {}", keyframe.frame_index);
+      continue;
+    }
+
+    const auto [width, height] = resolveOutputSize(size, m_frame->width, m_frame->height);
+    const int num_bytes = av_image_get_buffer_size(toAVPixelFormat(m_options.output_format), width, height, 1);
+    if (num_bytes < 0) { continue; }
+    std::vector<uint8_t> buffer = acquire_buffer(static_cast<size_t>(num_bytes));
+    if (!scale_frame(m_thumbnail_sws_context, width, height, buffer)) {
+      recycleFrame(std::move(buffer));
+      continue;
+    }
+    ++m_stats.frames_returned;
+    callback(static_cast<size_t>(keyframe.frame_index), std::move(buffer));
+  }
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::decode_keyframe(const TSFrameIndex::Keyframe &keyframe)
+{
+  // Demux up to the key packet; the packets in between are skipped without decoding.
+  bool found = false;
+  while (av_read_frame(m_container, m_packet) >= 0) {
+    if (m_packet->stream_index == m_stream->index && (m_packet->flags & AV_PKT_FLAG_KEY) != 0
+        && (m_packet->pts == AV_NOPTS_VALUE || m_packet->pts >= keyframe.pts)) {
+      found = true;
+      break;
+    }
+    av_packet_unref(m_packet);
+  }
+  if (!found) { return false; }
+
+  // Send the key packet alone and drain, so the frame is returned right away.
+  avcodec_flush_buffers(m_thumbnail_decoder);
+  int ret = avcodec_send_packet(m_thumbnail_decoder, m_packet);
+  av_packet_unref(m_packet);
+  if (ret < 0) { return false; }
+  avcodec_send_packet(m_thumbnail_decoder, nullptr);
+  ret = avcodec_receive_frame(m_thumbnail_decoder, m_frame);
+  avcodec_flush_buffers(m_thumbnail_decoder);
+  if (ret < 0) { return false; }
+  ++m_stats.frames_decoded;
+  return true;
+}
+
 double TSFrameExtractor::TSFrameExtractorImpl::getFrameRate() const
 {
   // Return the frame rate using the average frame rate from the stream.
@@ -544,25 +2011,145 @@ double TSFrameExtractor::TSFrameExtractorImpl::getDuration() const
 
 std::vector<int> TSFrameExtractor::TSFrameExtractorImpl::getKeyframePositions() const
 {
-  // Extract keys from the keyframe map.
-  std::vector<int> positions;
-  for (const auto &kv : m_keyframe_positions) { positions.push_back(kv.first); }
-  return positions;
+  return m_index->keyframePositions();
 }
 
 void TSFrameExtractor::TSFrameExtractorImpl::set_sequence_active(bool active)
 {
-  spdlog::info("Setting sequence active to {}", active);
+  spdlog::debug("Setting sequence active to {}", active);
   m_sequential_active = active;
 }
 
 std::optional<FrameSize> TSFrameExtractor::TSFrameExtractorImpl::getFrameSize() const { return m_frame_size; }
 
+TSFrameExtractor::DecodeStats TSFrameExtractor::TSFrameExtractorImpl::getDecodeStats() const { return m_stats; }
+
+PixelFormat TSFrameExtractor::TSFrameExtractorImpl::getOutputFormat() const { return m_options.output_format; }
+
+bool TSFrameExtractor::TSFrameExtractorImpl::isIndexCached() const { return m_index_cached; }
+
+bool TSFrameExtractor::TSFrameExtractorImpl::isMemoryMapped() const
+{
+  return m_mapping != nullptr && m_memory_data != nullptr;
+}
+
+double TSFrameExtractor::TSFrameExtractorImpl::getIndexingProgress() const
+{
+  if (m_index_complete) { return 1.0; }
+  if (m_source_size <= 0) { return 0.0; }
+  return std::clamp(static_cast<double>(m_indexed_bytes) / static_cast<double>(m_source_size), 0.0, 1.0);
+}
+
+bool TSFrameExtractor::TSFrameExtractorImpl::isIndexComplete() const { return m_index_complete; }
+
+bool TSFrameExtractor::TSFrameExtractorImpl::waitForIndex(double timeout_seconds) const
+{
+  std::unique_lock<std::mutex> lock(m_index_mutex);
+  m_index_cv.wait_for(
+    lock, std::chrono::duration<double>(timeout_seconds), [this]() { return m_indexing_done; });
+  return m_index_complete;
+}
+
+std::shared_ptr<TSFrameIndex> TSFrameExtractor::TSFrameExtractorImpl::getCompleteIndex() const
+{
+  std::unique_lock<std::mutex> lock(m_index_mutex);
+  m_index_cv.wait(lock, [this]() { return m_indexing_done; });
+  if (!m_index_complete) {
+    spdlog::error("Cannot share an incomplete index of {}", m_filename);
+    throw std::runtime_error("Cannot share an incomplete index of " + m_filename);
+  }
+  return m_index;
+}
+
+const std::string &TSFrameExtractor::TSFrameExtractorImpl::getFilename() const { return m_filename; }
+
+bool TSFrameExtractor::TSFrameExtractorImpl::waitForFrames(size_t count, double timeout_seconds) const
+{
+  std::unique_lock<std::mutex> lock(m_index_mutex);
+  m_index_cv.wait_for(lock, std::chrono::duration<double>(timeout_seconds), [this, count]() {
+    return m_indexing_done || getTotalFrames() >= count;
+  });
+  return getTotalFrames() >= count;
+}
+
+void TSFrameExtractor::TSFrameExtractorImpl::stopFollowing() { m_stop_following = true; }
+
+bool TSFrameExtractor::TSFrameExtractorImpl::isFollowing() const
+{
+  return m_options.follow && !m_index_complete && !m_stop_following;
+}
+
+std::unique_ptr<TSFrameExtractor::TSFrameExtractorImpl> TSFrameExtractor::TSFrameExtractorImpl::clone(
+  const TSFrameExtractor::Options &options) const
+{
+  // A caller-owned buffer is shared as is; a file is opened, and mapped, again.
+  if (m_mapping == nullptr && m_memory_data != nullptr) {
+    return std::make_unique<TSFrameExtractorImpl>(m_memory_data, m_memory_size, options, getCompleteIndex());
+  }
+  return std::make_unique<TSFrameExtractorImpl>(m_filename, options, getCompleteIndex());
+}
+
+std::optional<size_t> TSFrameExtractor::TSFrameExtractorImpl::findFrameByPts(int64_t pts,
+  TSFrameExtractor::TimestampMatch match) const
+{
+  // While indexing runs, a later timestamp may belong to a frame that is not indexed yet.
+  if (!m_index_complete) {
+    const size_t indexed_frames = m_index->frameCount();
+    const auto last_pts = indexed_frames > 0 ? m_index->ptsForFrame(indexed_frames - 1) : std::nullopt;
+    if (!last_pts.has_value() || pts > last_pts.value()) { return std::nullopt; }
+  }
+
+  switch (match) {
+  case TSFrameExtractor::TimestampMatch::EXACT:
+    return m_index->frameIndexForPts(pts);
+  case TSFrameExtractor::TimestampMatch::NEAREST:
+    return m_index->nearestFrameIndexForPts(pts);
+  case TSFrameExtractor::TimestampMatch::AT_OR_BEFORE:
+    return m_index->frameIndexAtOrBeforePts(pts);
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> TSFrameExtractor::TSFrameExtractorImpl::ptsAtTime(double seconds) const
+{
+  const auto origin = m_index->ptsForFrame(0);
+  const double time_base = av_q2d(m_stream->time_base);
+  if (!origin.has_value() || time_base <= 0) { return std::nullopt; }
+  return origin.value() + static_cast<int64_t>(std::llround(seconds / time_base));
+}
+
+std::optional<int64_t> TSFrameExtractor::TSFrameExtractorImpl::getFramePts(size_t frame_number) const
+{
+  return m_index->ptsForFrame(frame_number);
+}
+
+std::optional<double> TSFrameExtractor::TSFrameExtractorImpl::getFrameTime(size_t frame_number) const
+{
+  const auto origin = m_index->ptsForFrame(0);
+  const auto pts = m_index->ptsForFrame(frame_number);
+  if (!origin.has_value() || !pts.has_value()) { return std::nullopt; }
+  return static_cast<double>(pts.value() - origin.value()) * av_q2d(m_stream->time_base);
+}
+
 size_t TSFrameExtractor::TSFrameExtractorImpl::getTotalFrames() const
 {
+  // A followed file has as many frames as have been indexed so far.
+  if (m_options.follow) { return m_index->frameCount(); }
+
+  // The complete index counts every frame; the estimate only covers an index in progress.
+  if (m_index_complete) {
+    if (const size_t indexed_frames = m_index->frameCount(); indexed_frames > 0) { return indexed_frames; }
+  }
   return m_frame_count.has_value() ? m_frame_count.value() : 0;
 }
 
+FrameCache::Stats TSFrameExtractor::TSFrameExtractorImpl::getCacheStats() const
+{
+  return m_frame_cache != nullptr ? m_frame_cache->getStats() : FrameCache::Stats{};
+}
+
+size_t TSFrameExtractor::TSFrameExtractorImpl::getIndexMemoryUsage() const { return m_index->memoryUsage(); }
+
 size_t TSFrameExtractor::getTotalFrames() const { return m_impl->getTotalFrames(); }
 
 double TSFrameExtractor::getFrameRate() const { return m_impl->getFrameRate(); }
@@ -571,9 +2158,25 @@ double TSFrameExtractor::getDuration() const { return m_impl->getDuration(); }
 
 std::vector<int> TSFrameExtractor::getKeyframePositions() const { return m_impl->getKeyframePositions(); }
 
-TSFrameExtractor::TSFrameExtractor(const std::string &filename)
+TSFrameExtractor::TSFrameExtractor(const std::string &filename) : TSFrameExtractor(filename, Options{}) {}
+
+TSFrameExtractor::TSFrameExtractor(const std::string &filename, const Options &options)
+{
+  m_impl = std::make_unique<TSFrameExtractorImpl>(filename, options);
+}
+
+TSFrameExtractor::TSFrameExtractor(std::unique_ptr<TSFrameExtractorImpl> impl) : m_impl(std::move(impl)) {}
+
+TSFrameExtractor::TSFrameExtractor(const uint8_t *data, size_t size) : TSFrameExtractor(data, size, Options{}) {}
+
+TSFrameExtractor::TSFrameExtractor(const uint8_t *data, size_t size, const Options &options)
 {
-  m_impl = std::make_unique<TSFrameExtractorImpl>(filename);
+  m_impl = std::make_unique<TSFrameExtractorImpl>(data, size, options);
+}
+
+std::unique_ptr<TSFrameExtractor> TSFrameExtractor::clone(const Options &options) const
+{
+  return std::unique_ptr<TSFrameExtractor>(new TSFrameExtractor(m_impl->clone(options)));
 }
 
 std::optional<std::vector<uint8_t>> TSFrameExtractor::getFrame(size_t frame_number)
@@ -581,7 +2184,137 @@ std::optional<std::vector<uint8_t>> TSFrameExtractor::getFrame(size_t frame_numb
   return m_impl->getFrame(frame_number);
 }
 
+std::optional<std::vector<uint8_t>> TSFrameExtractor::getFrame(size_t frame_number, const std::atomic<bool> &cancel)
+{
+  return m_impl->getFrame(frame_number, cancel);
+}
+
 std::optional<netxten::types::FrameSize> TSFrameExtractor::getFrameSize() const { return m_impl->getFrameSize(); }
 
+std::optional<std::vector<uint8_t>> TSFrameExtractor::getFrameByPts(int64_t pts, TimestampMatch match)
+{
+  const auto frame_number = m_impl->findFrameByPts(pts, match);
+  if (!frame_number.has_value()) { return std::nullopt; }
+  return m_impl->getFrame(frame_number.value());
+}
+
+std::optional<std::vector<uint8_t>> TSFrameExtractor::getFrameAtTime(double seconds, TimestampMatch match)
+{
+  const auto frame_number = findFrameAtTime(seconds, match);
+  if (!frame_number.has_value()) { return std::nullopt; }
+  return m_impl->getFrame(frame_number.value());
+}
+
+std::optional<size_t> TSFrameExtractor::findFrameByPts(int64_t pts, TimestampMatch match) const
+{
+  return m_impl->findFrameByPts(pts, match);
+}
+
+std::optional<size_t> TSFrameExtractor::findFrameAtTime(double seconds, TimestampMatch match) const
+{
+  const auto pts = m_impl->ptsAtTime(seconds);
+  if (!pts.has_value()) { return std::nullopt; }
+  return m_impl->findFrameByPts(pts.value(), match);
+}
+
+std::optional<int64_t> TSFrameExtractor::getFramePts(size_t frame_number) const
+{
+  return m_impl->getFramePts(frame_number);
+}
+
+std::optional<double> TSFrameExtractor::getFrameTime(size_t frame_number) const
+{
+  return m_impl->getFrameTime(frame_number);
+}
+
+std::vector<std::optional<std::vector<uint8_t>>> TSFrameExtractor::getFrames(const std::vector<size_t> &frame_numbers)
+{
+  std::vector<std::optional<std::vector<uint8_t>>> frames(frame_numbers.size());
+
+  // Positions of every requested frame, so duplicates receive their own copy.
+  std::vector<std::pair<size_t, size_t>> order;
+  order.reserve(frame_numbers.size());
+  for (size_t position = 0; position < frame_numbers.size(); ++position) {
+    order.emplace_back(frame_numbers[position], position);
+  }
+  std::sort(order.begin(), order.end());
+
+  auto next = order.begin();
+  m_impl->getFrames(frame_numbers, [&](size_t frame_number, std::vector<uint8_t> &&frame) {
+    while (next != order.end() && next->first < frame_number) { ++next; }
+    auto last = next;
+    while (last != order.end() && last->first == frame_number) { ++last; }
+    if (next == last) { return; }
+    for (auto it = std::next(next); it != last; ++it) { frames[it->second] = frame; }
+    frames[next->second] = std::move(frame);
+    next = last;
+  });
+  return frames;
+}
+
+void TSFrameExtractor::getFrames(const std::vector<size_t> &frame_numbers, const FrameCallback &callback)
+{
+  m_impl->getFrames(frame_numbers, callback);
+}
+
+void TSFrameExtractor::getFrames(size_t first, size_t last, size_t step, const FrameCallback &callback)
+{
+  if (step == 0) { throw std::invalid_argument("Frame step must be positive"); }
+  std::vector<size_t> frame_numbers;
+  for (size_t frame_number = first; frame_number < last; frame_number += step) { frame_numbers.push_back(frame_number); }
+  m_impl->getFrames(frame_numbers, callback);
+}
+
+void TSFrameExtractor::getKeyframeThumbnails(const std::vector<size_t> &frame_numbers,
+  netxten::types::FrameSize size,
+  const FrameCallback &callback)
+{
+  m_impl->getKeyframeThumbnails(frame_numbers, size, callback);
+}
+
+std::vector<std::pair<size_t, std::vector<uint8_t>>> TSFrameExtractor::getThumbnailStrip(size_t count,
+  netxten::types::FrameSize size)
+{
+  std::vector<size_t> frame_numbers;
+  const size_t total_frames = getTotalFrames();
+  if (count == 0 || total_frames == 0) { return {}; }
+  for (size_t i = 0; i < count; ++i) { frame_numbers.push_back(i * total_frames / count); }
+
+  std::vector<std::pair<size_t, std::vector<uint8_t>>> thumbnails;
+  m_impl->getKeyframeThumbnails(frame_numbers, size, [&thumbnails](size_t frame_number, std::vector<uint8_t> &&frame) {
+    thumbnails.emplace_back(frame_number, std::move(frame));
+  });
+  return thumbnails;
+}
+
+void TSFrameExtractor::recycleFrame(std::vector<uint8_t> &&buffer) { m_impl->recycleFrame(std::move(buffer)); }
+
+TSFrameExtractor::DecodeStats TSFrameExtractor::getDecodeStats() const { return m_impl->getDecodeStats(); }
+
+FrameCache::Stats TSFrameExtractor::getCacheStats() const { return m_impl->getCacheStats(); }
+
+netxten::types::PixelFormat TSFrameExtractor::getOutputFormat() const { return m_impl->getOutputFormat(); }
+
+bool TSFrameExtractor::isIndexCached() const { return m_impl->isIndexCached(); }
+
+bool TSFrameExtractor::isMemoryMapped() const { return m_impl->isMemoryMapped(); }
+
+double TSFrameExtractor::getIndexingProgress() const { return m_impl->getIndexingProgress(); }
+
+bool TSFrameExtractor::waitForFrames(size_t count, double timeout_seconds) const
+{
+  return m_impl->waitForFrames(count, timeout_seconds);
+}
+
+void TSFrameExtractor::stopFollowing() { m_impl->stopFollowing(); }
+
+bool TSFrameExtractor::isFollowing() const { return m_impl->isFollowing(); }
+
+bool TSFrameExtractor::isIndexComplete() const { return m_impl->isIndexComplete(); }
+
+bool TSFrameExtractor::waitForIndex(double timeout_seconds) const { return m_impl->waitForIndex(timeout_seconds); }
+
+size_t TSFrameExtractor::getIndexMemoryUsage() const { return m_impl->getIndexMemoryUsage(); }
+
 
 TSFrameExtractor::~TSFrameExtractor() = default;
\ No newline at end of file
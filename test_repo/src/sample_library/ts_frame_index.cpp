@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <test_repo/mapped_file.hpp>
+#include <test_repo/ts_frame_index.hpp>
+
+using namespace netxten::utils;
+
+namespace {
+
+constexpr std::array<char, 8> INDEX_CACHE_MAGIC = { 'N', 'X', 'T', 'S', 'I', 'D', 'X', '\0' };//*< Sidecar magic.
+constexpr uint32_t INDEX_CACHE_VERSION = 3;//*< Sidecar layout version; 3 keeps every keyframe.
+
+/**
+ * @brief Fixed-size header at the start of the index sidecar file.
+ *
+ * The header is followed by keyframe_count TSFrameIndex::Keyframe records and frame_count
+ * int64_t timestamps in ascending order. Values are stored in native byte order; the
+ * sidecar is a local cache, not an interchange format.
+ */
+struct IndexCacheHeader
+{
+  std::array<char, 8> magic;//*< INDEX_CACHE_MAGIC.
+  uint32_t version;//*< INDEX_CACHE_VERSION.
+  uint32_t reserved;//*< Padding, always zero.
+  uint64_t source_size;//*< Size of the indexed video in bytes.
+  int64_t source_mtime;//*< Modification time of the indexed video.
+  uint64_t frame_count;//*< Number of timestamps.
+  uint64_t keyframe_count;//*< Number of keyframe records.
+};
+
+static_assert(sizeof(TSFrameIndex::Keyframe) == 32, "Keyframe records are written to the sidecar as is");
+
+}// namespace
+
+void TSFrameIndex::append(const std::vector<int64_t> &pts, const std::vector<Keyframe> &keyframes)
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  m_pts.reserve(m_pts.size() + pts.size());
+  for (const int64_t value : pts) {
+    if (m_pts.empty() || value >= m_pts.back()) {
+      m_pts.push_back(value);
+    } else {
+      // B-frames arrive before the frames they precede in presentation order.
+      m_pts.insert(std::upper_bound(m_pts.begin(), m_pts.end(), value), value);
+    }
+  }
+  m_keyframes.insert(m_keyframes.end(), keyframes.begin(), keyframes.end());
+}
+
+void TSFrameIndex::clear()
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  m_pts.clear();
+  m_keyframes.clear();
+}
+
+void TSFrameIndex::shrinkToFit()
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  m_pts.shrink_to_fit();
+  m_keyframes.shrink_to_fit();
+}
+
+size_t TSFrameIndex::frameCount() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_pts.size();
+}
+
+size_t TSFrameIndex::keyframeCount() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_keyframes.size();
+}
+
+std::optional<TSFrameIndex::Keyframe> TSFrameIndex::keyframeAtOrBefore(size_t frame_index) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  auto it = std::upper_bound(m_keyframes.begin(),
+    m_keyframes.end(),
+    static_cast<uint64_t>(frame_index),
+    [](uint64_t index, const Keyframe &keyframe) { return index < keyframe.frame_index; });
+  if (it == m_keyframes.begin()) { return std::nullopt; }
+  return *std::prev(it);
+}
+
+bool TSFrameIndex::hasKeyframeAfter(size_t frame_index) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return !m_keyframes.empty() && m_keyframes.back().frame_index > frame_index;
+}
+
+std::optional<size_t> TSFrameIndex::frameIndexForPts(int64_t pts) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  auto it = std::lower_bound(m_pts.begin(), m_pts.end(), pts);
+  if (it == m_pts.end() || *it != pts) { return std::nullopt; }
+  return static_cast<size_t>(std::distance(m_pts.begin(), it));
+}
+
+std::optional<size_t> TSFrameIndex::frameIndexAtOrBeforePts(int64_t pts) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  auto it = std::upper_bound(m_pts.begin(), m_pts.end(), pts);
+  if (it == m_pts.begin()) { return std::nullopt; }
+  return static_cast<size_t>(std::distance(m_pts.begin(), it) - 1);
+}
+
+std::optional<size_t> TSFrameIndex::nearestFrameIndexForPts(int64_t pts) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  if (m_pts.empty()) { return std::nullopt; }
+  auto it = std::lower_bound(m_pts.begin(), m_pts.end(), pts);
+  if (it == m_pts.end()) { return m_pts.size() - 1; }
+  if (it != m_pts.begin() && pts - *std::prev(it) <= *it - pts) { --it; }
+  return static_cast<size_t>(std::distance(m_pts.begin(), it));
+}
+
+std::optional<int64_t> TSFrameIndex::ptsForFrame(size_t frame_index) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  if (frame_index >= m_pts.size()) { return std::nullopt; }
+  return m_pts[frame_index];
+}
+
+std::vector<int> TSFrameIndex::keyframePositions() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  std::vector<int> positions;
+  positions.reserve(m_keyframes.size());
+  for (const auto &keyframe : m_keyframes) { positions.push_back(static_cast<int>(keyframe.frame_index)); }
+  return positions;
+}
+
+size_t TSFrameIndex::memoryUsage() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_pts.capacity() * sizeof(int64_t) + m_keyframes.capacity() * sizeof(Keyframe);
+}
+
+bool TSFrameIndex::load(const std::string &path, uint64_t source_size, int64_t source_mtime)
+{
+  if (!std::filesystem::exists(path)) { return false; }
+
+  try {
+    MappedFile cache(path);
+    const uint8_t *data = cache.data();
+    if (cache.size() < sizeof(IndexCacheHeader)) {
+      spdlog::warn("Ignoring truncated index cache: {}", path);
+      return false;
+    }
+
+    IndexCacheHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != INDEX_CACHE_MAGIC || header.version != INDEX_CACHE_VERSION) {
+      spdlog::warn("Ignoring index cache with unknown format: {}", path);
+      return false;
+    }
+    if (header.source_size != source_size || header.source_mtime != source_mtime) {
+      spdlog::info("Ignoring stale index cache: {}", path);
+      return false;
+    }
+    const uint64_t expected_size =
+      sizeof(IndexCacheHeader) + header.keyframe_count * sizeof(Keyframe) + header.frame_count * sizeof(int64_t);
+    if (cache.size() != expected_size) {
+      spdlog::warn("Ignoring index cache with unexpected size: {}", path);
+      return false;
+    }
+
+    // Both arrays are stored flat, so each is a single copy out of the mapping.
+    std::vector<Keyframe> keyframes(static_cast<size_t>(header.keyframe_count));
+    std::vector<int64_t> pts(static_cast<size_t>(header.frame_count));
+    const uint8_t *cursor = data + sizeof(IndexCacheHeader);
+    if (!keyframes.empty()) { std::memcpy(keyframes.data(), cursor, keyframes.size() * sizeof(Keyframe)); }
+    cursor += keyframes.size() * sizeof(Keyframe);
+    if (!pts.empty()) { std::memcpy(pts.data(), cursor, pts.size() * sizeof(int64_t)); }
+    if (!std::is_sorted(pts.begin(), pts.end())) {
+      spdlog::warn("Ignoring index cache with unsorted timestamps: {}", path);
+      return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_pts = std::move(pts);
+    m_keyframes = std::move(keyframes);
+  } catch (const std::exception &e) {
+    spdlog::warn("Failed to read index cache {}: {}", path, e.what());
+    return false;
+  }
+  return true;
+}
+
+bool TSFrameIndex::save(const std::string &path, uint64_t source_size, int64_t source_mtime) const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  IndexCacheHeader header{};
+  header.magic = INDEX_CACHE_MAGIC;
+  header.version = INDEX_CACHE_VERSION;
+  header.source_size = source_size;
+  header.source_mtime = source_mtime;
+  header.frame_count = m_pts.size();
+  header.keyframe_count = m_keyframes.size();
+
+  // Write to a temporary file first so readers never map a partially written cache.
+  const std::string temp_path = path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      spdlog::warn("Failed to create index cache: {}", path);
+      return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(m_keyframes.data()),
+      static_cast<std::streamsize>(m_keyframes.size() * sizeof(Keyframe)));
+    out.write(
+      reinterpret_cast<const char *>(m_pts.data()), static_cast<std::streamsize>(m_pts.size() * sizeof(int64_t)));
+    if (!out.good()) {
+      spdlog::warn("Failed to write index cache: {}", path);
+      out.close();
+      std::error_code error;
+      std::filesystem::remove(temp_path, error);
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  if (error) {
+    spdlog::warn("Failed to store index cache {}: {}", path, error.message());
+    std::filesystem::remove(temp_path, error);
+    return false;
+  }
+  return true;
+}
@@ -1,16 +1,80 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
 #include <test_repo/constants.hpp>
+#include <test_repo/gray_conversion.hpp>
 #include <test_repo/ts_grabber.hpp>
+#include <thread>
 
 using namespace netxten::utils;
+using netxten::types::PixelFormat;
 
+struct TSGrabber::Prefetcher
+{
+  size_t depth = 0;//*< Maximum number of queued frames.
+  std::thread worker;//*< Worker thread decoding ahead.
+  std::mutex mutex;//*< Guards the members below.
+  std::condition_variable cv;//*< Signalled when the queue or the request state changes.
+  std::deque<std::pair<size_t, std::vector<uint8_t>>> queue;//*< Decoded frames in frame order.
+  std::vector<std::vector<uint8_t>> recycled;//*< Buffers to hand back to the extractor.
+  std::optional<size_t> next_index;//*< Frame the caller requests next if access is sequential.
+  size_t next_frame = 0;//*< Next frame the worker decodes.
+  bool active = false;//*< Flag indicating access is sequential and the worker should decode.
+  bool stop = false;//*< Requests the worker to exit.
+  uint64_t generation = 0;//*< Bumped whenever the queue is dropped, to discard in-flight frames.
+  PrefetchStats stats;//*< Prefetch counters.
+};
+
+struct TSGrabber::Requester
+{
+  /**
+   * @brief A frame request waiting for the worker.
+   */
+  struct Request
+  {
+    size_t index = 0;//*< Requested frame.
+    std::promise<cv::Mat> promise;//*< Resolved with the frame, or an empty image if cancelled.
+  };
+
+  std::thread worker;//*< Worker thread decoding the requests.
+  std::mutex mutex;//*< Guards the members below, except the cancel flag.
+  std::condition_variable cv;//*< Signalled when a request arrives or the worker must stop.
+  std::deque<Request> pending;//*< Requests not started yet, oldest first.
+  bool busy = false;//*< Flag indicating the worker is decoding a request.
+  bool stop = false;//*< Requests the worker to exit.
+  std::atomic<bool> cancel_current{ false };//*< Abandons the request being decoded.
+  RequestStats stats;//*< Request counters.
+
+  /**
+   * @brief Resolves every pending request with an empty image and cancels the running one.
+   *
+   * Must be called with the mutex held.
+   */
+  void cancel_all()
+  {
+    for (auto &request : pending) { request.promise.set_value(cv::Mat{}); }
+    stats.cancelled += pending.size();
+    pending.clear();
+    if (busy) { cancel_current = true; }
+  }
+};
 
-TSGrabber::TSGrabber(const std::string &file_path, bool convert_to_16_bit)
-  : FrameGrabberBase(file_path), m_convert_to_16bit(convert_to_16_bit)
+TSGrabber::TSGrabber(const std::string &file_path, bool convert_to_16_bit, bool native_gray)
+  : FrameGrabberBase(file_path), m_convert_to_16bit(convert_to_16_bit), m_native_gray(native_gray)
 {
   spdlog::info("TSGrabber::TSGrabber({})", file_path);
 }
 
+TSGrabber::~TSGrabber()
+{
+  // The request worker uses the prefetcher, so it is stopped first.
+  stop_requests();
+  stop_prefetch();
+}
+
 size_t TSGrabber::getNumberOfFrames() const
 {
   checkInitialization();
@@ -21,52 +85,189 @@ cv::Mat TSGrabber::getCvFrame(size_t index) const
 {
   checkInitialization();
 
-  // Retrieve raw frame data (BGR24) from the extractor.
-  auto frame_opt = m_extractor->getFrame(index);
+  // Retrieve raw frame data in the extractor's output format.
+  auto frame_opt = fetch_frame(index);
   if (!frame_opt.has_value() || frame_opt->empty()) {
     spdlog::warn("[TSGrabber] Failed to read frame at index {}", index);
     return cv::Mat{};
   }
 
-  // Create a cv::Mat from the raw data.
-  cv::Mat bgr_image(
-    static_cast<int>(m_frame_size.height), static_cast<int>(m_frame_size.width), CV_8UC3, frame_opt->data());
+  cv::Mat image_16 = to_gray16(frame_opt.value());
+
+  // The converted image owns its data, so the decoded buffer can be reused by the extractor.
+  recycle_frame(std::move(frame_opt.value()));
+
+  return image_16;
+}
+
+bool TSGrabber::getFrameInto(size_t index, cv::Mat &frame) const
+{
+  checkInitialization();
+  return readSequential(index, frame);
+}
+
+netxten::types::FrameView TSGrabber::getFrameView(size_t index) const
+{
+  checkInitialization();
 
-  // Convert to grayscale if necessary.
-  cv::Mat gray_image;
-  if (bgr_image.channels() == 3) {
-    cv::cvtColor(bgr_image, gray_image, cv::COLOR_BGR2GRAY);
-  } else {
-    gray_image = std::move(bgr_image);
+  auto frame_opt = fetch_frame(index);
+  if (!frame_opt.has_value() || frame_opt->empty()) {
+    spdlog::warn("[TSGrabber] Failed to read frame at index {}", index);
+    return netxten::types::FrameView{};
   }
 
-  cv::Mat image_16;
-  if (m_convert_to_16bit) {
-    // Multiply 8-bit grayscale image by 257 to scale to 16-bit.
-    gray_image.convertTo(image_16, CV_16U, SCALE_FACTOR);
-  } else {
-    gray_image.convertTo(image_16, CV_16U);
+  netxten::types::FrameMetadata metadata;
+  metadata.index = index;
+  {
+    std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+    metadata.pts = m_extractor->getFramePts(index);
+    metadata.time = m_extractor->getFrameTime(index);
+  }
+
+  const auto rows = static_cast<int>(m_frame_size.height);
+  const auto cols = static_cast<int>(m_frame_size.width);
+  constexpr size_t alignment = netxten::types::FrameView::ALIGNMENT;
+  const size_t row_bytes = static_cast<size_t>(cols) * sizeof(uint16_t);
+  const bool aligned = reinterpret_cast<uintptr_t>(frame_opt->data()) % alignment == 0 && row_bytes % alignment == 0;
+  if (m_extractor->getOutputFormat() == PixelFormat::GRAY16 && aligned) {
+    // The decode buffer already holds the final pixels: the view takes it over.
+    auto buffer = std::make_shared<std::vector<uint8_t>>(std::move(frame_opt.value()));
+    const uint8_t *data = buffer->data();
+    return netxten::types::FrameView(
+      std::move(buffer), data, rows, cols, static_cast<size_t>(cols) * sizeof(uint16_t), CV_16U, metadata);
   }
 
+  // Pad the rows so that every row of the view starts on an aligned address.
+  const size_t step = (row_bytes + alignment - 1) / alignment * alignment;
+  cv::Mat storage(rows, static_cast<int>(step / sizeof(uint16_t)), CV_16U);
+  cv::Mat image_16 = storage.colRange(0, cols);
+  to_gray16(frame_opt.value(), image_16);
+  recycle_frame(std::move(frame_opt.value()));
+  return netxten::types::FrameView(std::move(image_16), metadata);
+}
+
+void TSGrabber::beginSequential(size_t first, size_t step) const
+{
+  // Read-ahead only helps consecutive frames; strided ranges rely on the extractor's seek planning.
+  if (m_prefetcher == nullptr || m_pool != nullptr || step != 1) { return; }
+
+  // Start decoding ahead from the first frame instead of waiting for two consecutive requests.
+  reset_prefetch();
+  {
+    std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+    m_prefetcher->next_index = first;
+    m_prefetcher->next_frame = first;
+    m_prefetcher->active = true;
+  }
+  m_prefetcher->cv.notify_all();
+}
+
+bool TSGrabber::readSequential(size_t index, cv::Mat &frame) const
+{
+  auto frame_opt = fetch_frame(index);
+  if (!frame_opt.has_value() || frame_opt->empty()) {
+    spdlog::warn("[TSGrabber] Failed to read frame at index {}", index);
+    return false;
+  }
+  to_gray16(frame_opt.value(), frame);
+  recycle_frame(std::move(frame_opt.value()));
+  return true;
+}
+
+cv::Mat TSGrabber::to_gray16(std::vector<uint8_t> &frame) const
+{
+  cv::Mat image_16;
+  to_gray16(frame, image_16);
   return image_16;
 }
 
+void TSGrabber::to_gray16(std::vector<uint8_t> &frame, cv::Mat &image_16) const
+{
+  const auto rows = static_cast<int>(m_frame_size.height);
+  const auto cols = static_cast<int>(m_frame_size.width);
+  switch (m_extractor->getOutputFormat()) {
+  case PixelFormat::GRAY16:
+    // Already scaled 16-bit gray: only copy out of the decode buffer.
+    cv::Mat(rows, cols, CV_16U, frame.data()).copyTo(image_16);
+    break;
+  case PixelFormat::GRAY8:
+    // Single widening pass from 8-bit gray.
+    cv::Mat(rows, cols, CV_8U, frame.data()).convertTo(image_16, CV_16U, m_convert_to_16bit ? SCALE_FACTOR : 1.0);
+    break;
+  default:
+    // Default path: one fused pass from BGR24 to scaled 16-bit gray, bit-exact with cvtColor + convertTo.
+    image_16.create(rows, cols, CV_16U);
+    bgrToGray16(frame.data(),
+      static_cast<size_t>(cols) * 3,
+      image_16.ptr<uint16_t>(),
+      image_16.step[0],
+      rows,
+      cols,
+      m_convert_to_16bit ? static_cast<uint16_t>(SCALE_FACTOR) : uint16_t{ 1 });
+    break;
+  }
+}
+
+std::vector<cv::Mat> TSGrabber::getCvFrames(const std::vector<size_t> &indices) const
+{
+  // Decode each distinct frame once and share the image between duplicate indices.
+  std::vector<std::pair<size_t, size_t>> order;
+  order.reserve(indices.size());
+  for (size_t position = 0; position < indices.size(); ++position) { order.emplace_back(indices[position], position); }
+  std::sort(order.begin(), order.end());
+
+  std::vector<cv::Mat> frames(indices.size());
+  auto next = order.begin();
+  getCvFrames(indices, [&](size_t index, const cv::Mat &image) {
+    while (next != order.end() && next->first < index) { ++next; }
+    for (; next != order.end() && next->first == index; ++next) { frames[next->second] = image; }
+  });
+  return frames;
+}
+
+void TSGrabber::getCvFrames(const std::vector<size_t> &indices,
+  const std::function<void(size_t, const cv::Mat &)> &callback) const
+{
+  checkInitialization();
+  reset_prefetch();
+
+  std::vector<size_t> targets(indices);
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  if (targets.empty()) { return; }
+  if (targets.back() >= m_total_frames) {
+    throw std::out_of_range("Frame number " + std::to_string(targets.back()) + " out of range");
+  }
+
+  // Decode a batch under the lock, then hand it out unlocked so the callback can use the grabber.
+  // Batches continue where the decoder stopped, so each GOP is still decoded at most once.
+  std::vector<std::pair<size_t, cv::Mat>> images;
+  for (auto first = targets.begin(); first != targets.end();) {
+    const auto last = first + std::min<std::ptrdiff_t>(CALLBACK_BATCH_SIZE, targets.end() - first);
+    {
+      std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+      m_extractor->getFrames(std::vector<size_t>(first, last), [&](size_t index, std::vector<uint8_t> &&frame) {
+        images.emplace_back(index, to_gray16(frame));
+        m_extractor->recycleFrame(std::move(frame));
+      });
+    }
+    for (const auto &[index, image] : images) { callback(index, image); }
+    images.clear();
+    first = last;
+  }
+}
+
 std::vector<uint16_t> TSGrabber::getFrame(size_t index) const
 {
   checkInitialization();
 
-  // Retrieve the converted 16-bit frame.
-  cv::Mat image_16 = getCvFrame(index);
-  if (image_16.empty()) {
+  // Convert straight into the returned vector instead of going through a cv::Mat copy.
+  std::vector<uint16_t> frame(m_frame_size.height * m_frame_size.width);
+  if (!getFrameInto(index, frame.data(), frame.size())) {
     spdlog::warn("getFrame: empty frame at index {}", index);
     return {};
   }
-
-  // Assume the image data is continuous. Copy the data to a vector.
-  // TODO: Check if the image data is continuous.
-  size_t total_pixels = image_16.total();
-  const uint16_t *dataPtr = image_16.ptr<uint16_t>(0);
-  return std::vector<uint16_t>(dataPtr, dataPtr + total_pixels);
+  return frame;
 }
 
 std::pair<int, int> TSGrabber::getFrameSize() const
@@ -79,7 +280,7 @@ void TSGrabber::setup()
 {
   try {
     // Initialize TSFrameExtractor using the file path from the base class.
-    m_extractor = std::make_unique<TSFrameExtractor>(m_file_path);
+    m_extractor = std::make_unique<TSFrameExtractor>(m_file_path, extractor_options());
     auto _ = m_extractor->getFrame(0);
 
     // Check frame_size
@@ -104,8 +305,337 @@ void TSGrabber::setup()
   }
 }
 
+TSFrameExtractor::Options TSGrabber::extractor_options() const
+{
+  // Native gray output avoids the BGR24 round trip: 16-bit consumers get the final format from the decoder.
+  TSFrameExtractor::Options options;
+  if (m_native_gray) { options.output_format = m_convert_to_16bit ? PixelFormat::GRAY16 : PixelFormat::GRAY8; }
+  options.output_size = m_preview_size;
+  options.index_cache = m_index_cache;
+  options.index_cache_path = m_index_cache_path;
+  return options;
+}
+
+void TSGrabber::setIndexCache(bool enabled) { setIndexCache(enabled, std::string{}); }
+
+void TSGrabber::setIndexCache(bool enabled, std::string path)
+{
+  m_index_cache = enabled;
+  m_index_cache_path = std::move(path);
+}
+
+void TSGrabber::setReaderCount(size_t readers)
+{
+  checkInitialization();
+  reset_prefetch();
+
+  std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+  m_pool.reset();
+  if (readers == 1) { return; }
+  m_pool = std::make_unique<TSExtractorPool>(*m_extractor, readers, extractor_options());
+  spdlog::info("TSGrabber: up to {} concurrent readers", m_pool->getSize());
+}
+
+void TSGrabber::setPreviewSize(netxten::types::FrameSize size)
+{
+  checkInitialization();
+  reset_prefetch();
+
+  std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+  m_preview_size = size;
+
+  // The new extractor shares the index, so switching does not rescan the file.
+  auto extractor = m_extractor->clone(extractor_options());
+  auto frame = extractor->getFrame(0);
+  auto frame_size_opt = extractor->getFrameSize();
+  if (!frame_size_opt.has_value()) {
+    spdlog::error("Failed to get preview frame size from TS file: {}", m_file_path);
+    throw std::runtime_error("Failed to get preview frame size from TS file: " + m_file_path);
+  }
+  if (frame.has_value()) { extractor->recycleFrame(std::move(frame.value())); }
+
+  m_extractor = std::move(extractor);
+  m_frame_size = frame_size_opt.value();
+  if (m_pool != nullptr) {
+    m_pool = std::make_unique<TSExtractorPool>(*m_extractor, m_pool->getSize(), extractor_options());
+  }
+  spdlog::info("TSGrabber: frame size set to {}x{}", m_frame_size.width, m_frame_size.height);
+}
+
 double TSGrabber::getFrameRate() const
 {
   checkInitialization();
   return m_frame_rate;
-}
\ No newline at end of file
+}
+
+void TSGrabber::setPrefetchDepth(size_t depth)
+{
+  checkInitialization();
+  stop_prefetch();
+  if (depth == 0) { return; }
+
+  m_prefetcher = std::make_unique<Prefetcher>();
+  m_prefetcher->depth = depth;
+  m_prefetcher->worker = std::thread(&TSGrabber::prefetch_loop, this);
+  spdlog::info("TSGrabber: prefetching up to {} frames", depth);
+}
+
+std::future<cv::Mat> TSGrabber::requestCvFrame(size_t index)
+{
+  checkInitialization();
+  if (index >= m_total_frames) {
+    throw std::out_of_range("Frame number " + std::to_string(index) + " out of range");
+  }
+
+  if (m_requester == nullptr) {
+    m_requester = std::make_unique<Requester>();
+    m_requester->worker = std::thread(&TSGrabber::request_loop, this);
+  }
+
+  Requester &requester = *m_requester;
+  std::future<cv::Mat> future;
+  {
+    std::lock_guard<std::mutex> lock(requester.mutex);
+    if (m_request_policy == RequestPolicy::LATEST_WINS) { requester.cancel_all(); }
+    requester.pending.push_back(Requester::Request{ index, std::promise<cv::Mat>{} });
+    future = requester.pending.back().promise.get_future();
+    ++requester.stats.requests;
+  }
+  requester.cv.notify_all();
+  return future;
+}
+
+void TSGrabber::cancelRequests()
+{
+  if (m_requester == nullptr) { return; }
+  std::lock_guard<std::mutex> lock(m_requester->mutex);
+  m_requester->cancel_all();
+}
+
+void TSGrabber::setRequestPolicy(RequestPolicy policy) { m_request_policy = policy; }
+
+TSGrabber::RequestStats TSGrabber::getRequestStats() const
+{
+  if (m_requester == nullptr) { return RequestStats{}; }
+  std::lock_guard<std::mutex> lock(m_requester->mutex);
+  return m_requester->stats;
+}
+
+void TSGrabber::stop_requests()
+{
+  if (m_requester == nullptr) { return; }
+  {
+    std::lock_guard<std::mutex> lock(m_requester->mutex);
+    m_requester->cancel_all();
+    m_requester->stop = true;
+  }
+  m_requester->cv.notify_all();
+  if (m_requester->worker.joinable()) { m_requester->worker.join(); }
+  m_requester.reset();
+}
+
+void TSGrabber::request_loop()
+{
+  Requester &requester = *m_requester;
+  std::unique_lock<std::mutex> lock(requester.mutex);
+  while (true) {
+    requester.cv.wait(lock, [&requester]() { return requester.stop || !requester.pending.empty(); });
+    if (requester.stop) { return; }
+
+    Requester::Request request = std::move(requester.pending.front());
+    requester.pending.pop_front();
+    requester.busy = true;
+    requester.cancel_current = false;
+    lock.unlock();
+
+    // Requests are served by the single extractor, which can abandon a decode mid-GOP.
+    reset_prefetch();
+    cv::Mat image_16;
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+      try {
+        auto frame = m_extractor->getFrame(request.index, requester.cancel_current);
+        if (frame.has_value() && !frame->empty()) {
+          to_gray16(frame.value(), image_16);
+          m_extractor->recycleFrame(std::move(frame.value()));
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    requester.busy = false;
+    if (error != nullptr) {
+      request.promise.set_exception(error);
+    } else if (requester.cancel_current) {
+      ++requester.stats.cancelled;
+      request.promise.set_value(cv::Mat{});
+    } else {
+      if (image_16.empty()) { spdlog::warn("[TSGrabber] Failed to read frame at index {}", request.index); }
+      ++requester.stats.completed;
+      request.promise.set_value(std::move(image_16));
+    }
+  }
+}
+
+TSGrabber::PrefetchStats TSGrabber::getPrefetchStats() const
+{
+  if (m_prefetcher == nullptr) { return PrefetchStats{}; }
+  std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+  return m_prefetcher->stats;
+}
+
+void TSGrabber::stop_prefetch()
+{
+  if (m_prefetcher == nullptr) { return; }
+  {
+    std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+    m_prefetcher->stop = true;
+  }
+  m_prefetcher->cv.notify_all();
+  if (m_prefetcher->worker.joinable()) { m_prefetcher->worker.join(); }
+  m_prefetcher.reset();
+}
+
+std::optional<std::vector<uint8_t>> TSGrabber::fetch_frame(size_t index) const
+{
+  // Concurrent readers each decode on a context of the pool.
+  if (m_pool != nullptr) { return m_pool->getFrame(index); }
+
+  // Out of range requests go straight to the extractor, which reports them.
+  if (m_prefetcher == nullptr || index >= m_total_frames) {
+    std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+    return m_extractor->getFrame(index);
+  }
+
+  Prefetcher &prefetcher = *m_prefetcher;
+  std::vector<std::vector<uint8_t>> recycled;
+  bool sequential = false;
+  {
+    std::unique_lock<std::mutex> lock(prefetcher.mutex);
+    sequential = prefetcher.next_index == index;
+    prefetcher.next_index = index + 1;
+
+    if (sequential && prefetcher.active) {
+      // The worker produces frames in order; wait if it is still decoding this one.
+      prefetcher.cv.wait(lock, [&prefetcher]() { return !prefetcher.queue.empty() || !prefetcher.active; });
+      if (!prefetcher.queue.empty() && prefetcher.queue.front().first == index) {
+        auto frame = std::move(prefetcher.queue.front().second);
+        prefetcher.queue.pop_front();
+        ++prefetcher.stats.hits;
+        prefetcher.cv.notify_all();
+        return frame;
+      }
+    }
+
+    // Access is not sequential: drop the read-ahead and decode on this thread.
+    prefetcher.stats.discarded += prefetcher.queue.size();
+    for (auto &entry : prefetcher.queue) { prefetcher.recycled.push_back(std::move(entry.second)); }
+    prefetcher.queue.clear();
+    ++prefetcher.generation;
+    prefetcher.active = false;
+    ++prefetcher.stats.misses;
+    recycled.swap(prefetcher.recycled);
+  }
+
+  std::optional<std::vector<uint8_t>> frame;
+  {
+    std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+    for (auto &buffer : recycled) { m_extractor->recycleFrame(std::move(buffer)); }
+    frame = m_extractor->getFrame(index);
+  }
+
+  // Two consecutive requests start the read-ahead from the following frame.
+  if (sequential && frame.has_value()) {
+    {
+      std::lock_guard<std::mutex> lock(prefetcher.mutex);
+      prefetcher.active = true;
+      prefetcher.next_frame = index + 1;
+    }
+    prefetcher.cv.notify_all();
+  }
+  return frame;
+}
+
+void TSGrabber::reset_prefetch() const
+{
+  if (m_prefetcher == nullptr) { return; }
+  std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+  m_prefetcher->stats.discarded += m_prefetcher->queue.size();
+  for (auto &entry : m_prefetcher->queue) { m_prefetcher->recycled.push_back(std::move(entry.second)); }
+  m_prefetcher->queue.clear();
+  ++m_prefetcher->generation;
+  m_prefetcher->active = false;
+  m_prefetcher->next_index.reset();
+}
+
+void TSGrabber::recycle_frame(std::vector<uint8_t> &&buffer) const
+{
+  if (m_pool != nullptr) {
+    m_pool->recycleFrame(std::move(buffer));
+    return;
+  }
+
+  if (m_prefetcher == nullptr) {
+    std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+    m_extractor->recycleFrame(std::move(buffer));
+    return;
+  }
+
+  // The worker returns the buffers to the extractor while it holds the extractor lock.
+  std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+  if (m_prefetcher->recycled.size() < m_prefetcher->depth) { m_prefetcher->recycled.push_back(std::move(buffer)); }
+}
+
+void TSGrabber::prefetch_loop() const
+{
+  Prefetcher &prefetcher = *m_prefetcher;
+  std::unique_lock<std::mutex> lock(prefetcher.mutex);
+  while (true) {
+    prefetcher.cv.wait(lock, [this, &prefetcher]() {
+      return prefetcher.stop
+             || (prefetcher.active && prefetcher.queue.size() < prefetcher.depth
+                 && prefetcher.next_frame < m_total_frames);
+    });
+    if (prefetcher.stop) { return; }
+
+    const size_t frame_index = prefetcher.next_frame;
+    const uint64_t generation = prefetcher.generation;
+    std::vector<std::vector<uint8_t>> recycled;
+    recycled.swap(prefetcher.recycled);
+    lock.unlock();
+
+    std::optional<std::vector<uint8_t>> frame;
+    {
+      std::lock_guard<std::mutex> extractor_lock(m_extractor_mutex);
+      for (auto &buffer : recycled) { m_extractor->recycleFrame(std::move(buffer)); }
+      try {
+        frame = m_extractor->getFrame(frame_index);
+      } catch (const std::exception &e) {
+        spdlog::warn("[TSGrabber] Prefetch of frame {} failed: {}", frame_index, e.what());
+      }
+    }
+
+    lock.lock();
+    if (generation != prefetcher.generation) {
+      // The caller moved elsewhere while this frame was decoded.
+      if (frame.has_value()) {
+        ++prefetcher.stats.discarded;
+        prefetcher.recycled.push_back(std::move(frame.value()));
+      }
+      continue;
+    }
+    if (!frame.has_value()) {
+      // Let the caller decode on demand instead of waiting for a frame that will not come.
+      prefetcher.active = false;
+      prefetcher.cv.notify_all();
+      continue;
+    }
+    prefetcher.queue.emplace_back(frame_index, std::move(frame.value()));
+    prefetcher.next_frame = frame_index + 1;
+    ++prefetcher.stats.frames_prefetched;
+    prefetcher.cv.notify_all();
+  }
+}
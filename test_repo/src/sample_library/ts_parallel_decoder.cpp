@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <test_repo/ts_parallel_decoder.hpp>
+#include <thread>
+
+using namespace netxten::utils;
+
+namespace {
+
+/**
+ * @brief Thrown inside a worker's frame callback to abandon a stopped sweep.
+ */
+struct SweepStopped
+{
+};
+
+}// namespace
+
+TSParallelDecoder::TSParallelDecoder(const TSFrameExtractor &source) : TSParallelDecoder(source, Options{}) {}
+
+TSParallelDecoder::TSParallelDecoder(const TSFrameExtractor &source, const Options &options) : m_options(options)
+{
+  size_t worker_count = m_options.workers;
+  if (worker_count == 0) { worker_count = std::max(1U, std::thread::hardware_concurrency()); }
+
+  // Parallelism comes from the workers; each decoder runs on its own thread only.
+  TSFrameExtractor::Options worker_options;
+  worker_options.output_format = m_options.output_format;
+  worker_options.decoder_threads = 1;
+  worker_options.frame_threading = false;
+  worker_options.slice_threading = false;
+  worker_options.reverse_buffer_bytes = 0;
+
+  m_workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) { m_workers.push_back(source.clone(worker_options)); }
+  m_keyframes = m_workers.front()->getKeyframePositions();
+  m_total_frames = m_workers.front()->getTotalFrames();
+  spdlog::info("TSParallelDecoder: {} workers, {} keyframes", worker_count, m_keyframes.size());
+}
+
+TSParallelDecoder::~TSParallelDecoder() = default;
+
+std::vector<TSParallelDecoder::Segment> TSParallelDecoder::split(size_t first, size_t last) const
+{
+  std::vector<Segment> segments;
+  size_t start = first;
+  for (const int keyframe : m_keyframes) {
+    const auto boundary = static_cast<size_t>(keyframe);
+    if (boundary <= start) { continue; }
+    if (boundary >= last) { break; }
+    segments.push_back({ start, boundary });
+    start = boundary;
+  }
+  segments.push_back({ start, last });
+  return segments;
+}
+
+size_t TSParallelDecoder::run(const TSFrameExtractor::FrameCallback &callback)
+{
+  return run(0, m_total_frames, callback);
+}
+
+size_t TSParallelDecoder::run(size_t first, size_t last, const TSFrameExtractor::FrameCallback &callback)
+{
+  last = std::min(last, m_total_frames);
+  if (first >= last) { return 0; }
+
+  const std::vector<Segment> segments = split(first, last);
+  const bool ordered = m_options.delivery == Delivery::ORDERED;
+  const size_t capacity = std::max<size_t>(1, m_options.reorder_capacity);
+
+  std::atomic<size_t> next_segment{ 0 };
+  std::atomic<size_t> delivered{ 0 };
+  std::atomic<bool> stop{ false };
+
+  // Shared with the workers and guarded by mutex.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+  std::map<size_t, std::vector<uint8_t>> reorder_buffer;
+  std::vector<bool> segment_done(segments.size(), false);
+  size_t current_segment = 0;// Segment whose frames are delivered next in ordered mode.
+
+  auto fail = [&](std::exception_ptr exception) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) { error = std::move(exception); }
+      stop = true;
+    }
+    cv.notify_all();
+  };
+
+  auto work = [&](TSFrameExtractor &extractor) {
+    try {
+      for (size_t index = next_segment++; index < segments.size() && !stop; index = next_segment++) {
+        const Segment &segment = segments[index];
+        extractor.getFrames(segment.first, segment.last, 1, [&](size_t frame_number, std::vector<uint8_t> &&frame) {
+          if (stop) { throw SweepStopped{}; }
+          if (!ordered) {
+            callback(frame_number, std::move(frame));
+            ++delivered;
+            return;
+          }
+
+          // The segment being delivered may always add frames, so the buffer cannot deadlock.
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [&]() { return stop || index == current_segment || reorder_buffer.size() < capacity; });
+          if (stop) { throw SweepStopped{}; }
+          reorder_buffer.emplace(frame_number, std::move(frame));
+          lock.unlock();
+          cv.notify_all();
+        });
+
+        if (ordered) {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            segment_done[index] = true;
+          }
+          cv.notify_all();
+        }
+      }
+    } catch (const SweepStopped &) {
+      // Another thread failed; nothing to report.
+    } catch (...) {
+      fail(std::current_exception());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min(m_workers.size(), segments.size());
+  threads.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) { threads.emplace_back(work, std::ref(*m_workers[i])); }
+
+  if (ordered) {
+    // Hand out the frames of each segment in order, then move on to the next segment.
+    std::unique_lock<std::mutex> lock(mutex);
+    while (current_segment < segments.size()) {
+      const size_t segment_last = segments[current_segment].last;
+      cv.wait(lock, [&]() {
+        return stop || segment_done[current_segment]
+               || (!reorder_buffer.empty() && reorder_buffer.begin()->first < segment_last);
+      });
+      if (stop) { break; }
+
+      if (!reorder_buffer.empty() && reorder_buffer.begin()->first < segment_last) {
+        auto node = reorder_buffer.extract(reorder_buffer.begin());
+        lock.unlock();
+        cv.notify_all();
+        try {
+          callback(node.key(), std::move(node.mapped()));
+          ++delivered;
+        } catch (...) {
+          fail(std::current_exception());
+        }
+        lock.lock();
+        continue;
+      }
+
+      // All frames of the segment have been delivered.
+      ++current_segment;
+      cv.notify_all();
+    }
+  }
+
+  for (auto &thread : threads) { thread.join(); }
+  if (error) { std::rethrow_exception(error); }
+  return delivered;
+}
@@ -1,10 +1,26 @@
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <mutex>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <test_repo/frame_buffer_pool.hpp>
+#include <test_repo/frame_cache.hpp>
+#include <test_repo/gray_conversion.hpp>
+#include <test_repo/raw_grabber.hpp>
+#include <test_repo/ts_extractor_pool.hpp>
+#include <test_repo/ts_frame_index.hpp>
 #include <test_repo/ts_grabber.hpp>
+#include <test_repo/ts_parallel_decoder.hpp>
 
 // File paths for testing
 static const auto FILE_PATH_TS = "resources/Viento_LWIR-OGI-Test12-Run56-Methane-1kghr.ts";
@@ -84,4 +100,1028 @@ TEST_CASE("TSGrabber Uninitialized Tests", "[grabber]")
   // Run basic tests for SEQGrabber.
   spdlog::info("Running uninitialized tests for TSGrabber");
   test_uninitialized_grabber<netxten::utils::TSGrabber>();
-}
\ No newline at end of file
+}
+
+TEST_CASE("TSFrameExtractor steady-state decoding does not allocate", "[extractor]")
+{
+  TSFrameExtractor extractor(FILE_PATH_TS);
+  constexpr size_t warmup_frames = 2;
+  constexpr size_t steady_frames = 10;
+  REQUIRE(extractor.getTotalFrames() > warmup_frames + steady_frames);
+
+  // Warm up the decoder, the scaler and the buffer pool.
+  for (size_t i = 0; i < warmup_frames; ++i) {
+    auto frame = extractor.getFrame(i);
+    REQUIRE(frame.has_value());
+    extractor.recycleFrame(std::move(frame.value()));
+  }
+
+  const auto before = extractor.getDecodeStats();
+  for (size_t i = warmup_frames; i < warmup_frames + steady_frames; ++i) {
+    auto frame = extractor.getFrame(i);
+    REQUIRE(frame.has_value());
+    extractor.recycleFrame(std::move(frame.value()));
+  }
+  const auto after = extractor.getDecodeStats();
+
+  REQUIRE(after.frames_returned == before.frames_returned + steady_frames);
+  REQUIRE(after.packet_allocations == before.packet_allocations);
+  REQUIRE(after.frame_allocations == before.frame_allocations);
+  REQUIRE(after.scaler_allocations == before.scaler_allocations);
+  REQUIRE(after.buffer_allocations == before.buffer_allocations);
+}
+
+TEST_CASE("TSFrameExtractor output formats", "[extractor]")
+{
+  using netxten::types::PixelFormat;
+  for (auto format : { PixelFormat::BGR24, PixelFormat::GRAY8, PixelFormat::GRAY16, PixelFormat::YUV420P }) {
+    TSFrameExtractor::Options options;
+    options.output_format = format;
+    TSFrameExtractor extractor(FILE_PATH_TS, options);
+    REQUIRE(extractor.getOutputFormat() == format);
+
+    auto frame = extractor.getFrame(0);
+    REQUIRE(frame.has_value());
+    auto frame_size = extractor.getFrameSize();
+    REQUIRE(frame_size.has_value());
+    REQUIRE(frame->size() == netxten::types::frameBufferSize(format, frame_size.value()));
+  }
+}
+
+TEST_CASE("TSGrabber native gray decode path", "[grabber]")
+{
+  // The default grabber keeps the BGR24 conversion path.
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  TSGrabber bgr_grabber(FILE_PATH_TS, true, false);
+  bgr_grabber.initialize();
+  REQUIRE(cv::norm(grabber.getCvFrame(0), bgr_grabber.getCvFrame(0), cv::NORM_INF) == 0);
+
+  // Native gray is opt-in and must still produce full-size 16-bit frames.
+  TSGrabber gray_grabber(FILE_PATH_TS, true, true);
+  gray_grabber.initialize();
+  cv::Mat frame = gray_grabber.getCvFrame(0);
+  REQUIRE(frame.type() == CV_16U);
+  REQUIRE(frame.rows == TS_HEIGHT);
+  REQUIRE(frame.cols == TS_WIDTH);
+}
+
+TEST_CASE("TSFrameExtractor threaded decoding matches single-threaded output", "[extractor]")
+{
+  TSFrameExtractor::Options single_threaded;
+  single_threaded.decoder_threads = 1;
+  TSFrameExtractor::Options frame_threaded;
+  frame_threaded.decoder_threads = 4;
+  frame_threaded.slice_threading = false;
+
+  TSFrameExtractor reference(FILE_PATH_TS, single_threaded);
+  TSFrameExtractor threaded(FILE_PATH_TS, frame_threaded);
+  const size_t num_frames = std::min<size_t>(reference.getTotalFrames(), 20);
+
+  // Sequential reads must survive the pipeline delay of frame threading.
+  for (size_t i = 0; i < num_frames; ++i) {
+    auto expected = reference.getFrame(i);
+    auto actual = threaded.getFrame(i);
+    REQUIRE(expected.has_value());
+    REQUIRE(actual.has_value());
+    REQUIRE(expected.value() == actual.value());
+  }
+
+  // Random access after a seek flushes the pipeline.
+  const size_t middle = reference.getTotalFrames() / 2;
+  REQUIRE(reference.getFrame(middle) == threaded.getFrame(middle));
+}
+
+TEST_CASE("TSFrameExtractor reuses the index sidecar", "[extractor]")
+{
+  const auto cache_path = (std::filesystem::temp_directory_path() / "test_repo_index_cache.idx").string();
+  std::filesystem::remove(cache_path);
+
+  TSFrameExtractor::Options options;
+  options.index_cache = true;
+  options.index_cache_path = cache_path;
+
+  // The first open scans the file and writes the sidecar.
+  TSFrameExtractor scanned(FILE_PATH_TS, options);
+  REQUIRE_FALSE(scanned.isIndexCached());
+  REQUIRE(std::filesystem::exists(cache_path));
+
+  // The second open maps the sidecar and must see the same index.
+  TSFrameExtractor cached(FILE_PATH_TS, options);
+  REQUIRE(cached.isIndexCached());
+  REQUIRE(cached.getTotalFrames() == scanned.getTotalFrames());
+  REQUIRE(cached.getKeyframePositions() == scanned.getKeyframePositions());
+
+  const size_t middle = scanned.getTotalFrames() / 2;
+  REQUIRE(cached.getFrame(middle) == scanned.getFrame(middle));
+
+  // A sidecar that does not belong to the video is rejected.
+  {
+    std::ofstream corrupt(cache_path, std::ios::binary | std::ios::trunc);
+    corrupt << "not an index";
+  }
+  TSFrameExtractor rebuilt(FILE_PATH_TS, options);
+  REQUIRE_FALSE(rebuilt.isIndexCached());
+  REQUIRE(rebuilt.getTotalFrames() == scanned.getTotalFrames());
+  std::filesystem::remove(cache_path);
+
+  // Grabbers leave the recording's directory alone unless the sidecar is asked for.
+  const std::string default_path = std::string(FILE_PATH_TS) + ".idx";
+  std::filesystem::remove(default_path);
+  {
+    TSGrabber grabber(FILE_PATH_TS);
+    grabber.initialize();
+  }
+  REQUIRE_FALSE(std::filesystem::exists(default_path));
+  {
+    TSGrabber grabber(FILE_PATH_TS);
+    grabber.setIndexCache(true, cache_path);
+    grabber.initialize();
+  }
+  REQUIRE(std::filesystem::exists(cache_path));
+  std::filesystem::remove(cache_path);
+}
+
+TEST_CASE("TSFrameExtractor indexes in the background", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  TSFrameExtractor reference(FILE_PATH_TS, options);
+
+  options.background_indexing = true;
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  // Frames are available before indexing finishes; the frame count is estimated until then.
+  REQUIRE(extractor.getTotalFrames() > 0);
+  REQUIRE(extractor.getFrame(0) == reference.getFrame(0));
+
+  REQUIRE(extractor.waitForIndex(60.0));
+  REQUIRE(extractor.isIndexComplete());
+  REQUIRE(extractor.getIndexingProgress() == 1.0);
+  REQUIRE(extractor.getTotalFrames() == reference.getTotalFrames());
+  REQUIRE(extractor.getKeyframePositions() == reference.getKeyframePositions());
+
+  const size_t middle = reference.getTotalFrames() / 2;
+  REQUIRE(extractor.getFrame(middle) == reference.getFrame(middle));
+}
+
+TEST_CASE("TSFrameIndex lookups", "[index]")
+{
+  TSFrameIndex index;
+  // Decode order of an IPBB GOP: the B-frames are shown before the P-frame sent ahead of them.
+  index.append({ 0, 3000, 1000, 2000 }, { { 0, 0, -1000, 188 } });
+  index.append({ 4000, 7000, 5000, 6000 }, { { 4, 4000, 3000, 9400 } });
+
+  REQUIRE(index.frameCount() == 8);
+  REQUIRE(index.keyframePositions() == std::vector<int>{ 0, 4 });
+  REQUIRE(index.ptsForFrame(2) == 2000);
+  REQUIRE_FALSE(index.ptsForFrame(8).has_value());
+  REQUIRE(index.frameIndexForPts(3000) == 3);
+  REQUIRE_FALSE(index.frameIndexForPts(3500).has_value());
+  REQUIRE(index.frameIndexAtOrBeforePts(3999) == 3);
+  REQUIRE_FALSE(index.frameIndexAtOrBeforePts(-1).has_value());
+  REQUIRE(index.nearestFrameIndexForPts(3400) == 3);
+  REQUIRE(index.nearestFrameIndexForPts(3500) == 3);
+  REQUIRE(index.nearestFrameIndexForPts(3600) == 4);
+  REQUIRE(index.nearestFrameIndexForPts(99000) == 7);
+
+  REQUIRE(index.keyframeAtOrBefore(3)->frame_index == 0);
+  REQUIRE(index.keyframeAtOrBefore(4)->position == 9400);
+  REQUIRE(index.hasKeyframeAfter(3));
+  REQUIRE_FALSE(index.hasKeyframeAfter(4));
+
+  index.shrinkToFit();
+  REQUIRE(index.memoryUsage() == 8 * sizeof(int64_t) + 2 * sizeof(TSFrameIndex::Keyframe));
+}
+
+TEST_CASE("TSFrameExtractor frame index is exact and compact", "[extractor]")
+{
+  TSFrameExtractor extractor(FILE_PATH_TS);
+
+  // The last indexed frame must decode; an estimate past the end of the stream would not.
+  const size_t total_frames = extractor.getTotalFrames();
+  REQUIRE(total_frames > 0);
+  REQUIRE(extractor.getFrame(total_frames - 1).has_value());
+  REQUIRE_THROWS_AS(extractor.getFrame(total_frames), std::out_of_range);
+
+  // 8 bytes per frame plus one 32 byte record per keyframe.
+  const size_t keyframes = extractor.getKeyframePositions().size();
+  REQUIRE(extractor.getIndexMemoryUsage() == total_frames * 8 + keyframes * 32);
+  spdlog::info("Frame index uses {:.1f} MB per million frames",
+    static_cast<double>(extractor.getIndexMemoryUsage()) / static_cast<double>(total_frames));
+}
+
+TEST_CASE("FrameCache eviction policies", "[cache]")
+{
+  const std::vector<uint8_t> frame(100, 7);
+
+  SECTION("least recently used")
+  {
+    FrameCache cache(300, FrameCache::EvictionPolicy::LEAST_RECENTLY_USED);
+    cache.insert(1, frame.data(), frame.size());
+    cache.insert(2, frame.data(), frame.size());
+    cache.insert(3, frame.data(), frame.size());
+    REQUIRE(cache.lookup(1) != nullptr);
+    cache.insert(4, frame.data(), frame.size());
+    REQUIRE(cache.contains(1));
+    REQUIRE_FALSE(cache.contains(2));
+  }
+
+  SECTION("farthest from last access")
+  {
+    FrameCache cache(300, FrameCache::EvictionPolicy::FARTHEST_FROM_LAST_ACCESS);
+    cache.insert(10, frame.data(), frame.size());
+    cache.insert(20, frame.data(), frame.size());
+    cache.insert(30, frame.data(), frame.size());
+    REQUIRE(cache.lookup(28) == nullptr);
+    cache.insert(29, frame.data(), frame.size());
+    REQUIRE_FALSE(cache.contains(10));
+    REQUIRE(cache.contains(30));
+  }
+
+  SECTION("frames larger than the budget are not stored")
+  {
+    FrameCache cache(50);
+    cache.insert(1, frame.data(), frame.size());
+    REQUIRE_FALSE(cache.contains(1));
+  }
+}
+
+TEST_CASE("TSFrameExtractor serves backward steps from the frame cache", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  TSFrameExtractor reference(FILE_PATH_TS, options);
+
+  options.frame_cache_bytes = 64 * TS_HEIGHT * TS_WIDTH;
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  // Jump into a GOP past its keyframe, then step backwards one frame at a time.
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 2);
+  const auto target = static_cast<size_t>(keyframes[1] + 10);
+  REQUIRE(extractor.getFrame(target) == reference.getFrame(target));
+  const size_t decoded = extractor.getDecodeStats().frames_decoded;
+
+  for (size_t frame = target - 1; frame >= static_cast<size_t>(keyframes[1]); --frame) {
+    REQUIRE(extractor.getFrame(frame) == reference.getFrame(frame));
+  }
+  REQUIRE(extractor.getDecodeStats().frames_decoded == decoded);
+
+  const auto stats = extractor.getCacheStats();
+  REQUIRE(stats.hits == 10);
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.bytes <= options.frame_cache_bytes);
+}
+
+TEST_CASE("TSGrabber prefetches sequential frames", "[grabber]")
+{
+  TSGrabber reference(FILE_PATH_TS);
+  reference.initialize();
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  grabber.setPrefetchDepth(4);
+
+  constexpr size_t frame_count = 20;
+  for (size_t index = 0; index < frame_count; ++index) {
+    REQUIRE(grabber.getFrame(index) == reference.getFrame(index));
+  }
+  auto stats = grabber.getPrefetchStats();
+  REQUIRE(stats.hits > 0);
+  REQUIRE(stats.hits + stats.misses == frame_count);
+
+  // A jump drops the read-ahead and is decoded on demand.
+  const size_t jump = grabber.getNumberOfFrames() / 2;
+  REQUIRE(grabber.getFrame(jump) == reference.getFrame(jump));
+  REQUIRE(grabber.getFrame(jump + 1) == reference.getFrame(jump + 1));
+  stats = grabber.getPrefetchStats();
+  REQUIRE(stats.misses >= 2);
+  REQUIRE(stats.hits + stats.misses == frame_count + 2);
+
+  grabber.setPrefetchDepth(0);
+  REQUIRE(grabber.getFrame(jump + 2) == reference.getFrame(jump + 2));
+}
+
+TEST_CASE("TSFrameExtractor plays backwards without re-decoding each GOP", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  options.reverse_buffer_bytes = 64 * 1024 * 1024;
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 3);
+  const auto first = static_cast<size_t>(keyframes[1] - 5);
+  const auto last = static_cast<size_t>(keyframes[2] + 5);
+
+  // Forward reference frames, read sequentially.
+  std::vector<std::vector<uint8_t>> forward;
+  for (size_t frame = first; frame <= last; ++frame) { forward.push_back(extractor.getFrame(frame).value()); }
+
+  const size_t decoded_before = extractor.getDecodeStats().frames_decoded;
+  for (size_t frame = last; frame-- > first;) { REQUIRE(extractor.getFrame(frame) == forward[frame - first]); }
+
+  // Each GOP touched is decoded about once: far below one partial GOP decode per frame.
+  const size_t decoded = extractor.getDecodeStats().frames_decoded - decoded_before;
+  REQUIRE(decoded <= 3 * (last - first) + static_cast<size_t>(keyframes[1] - keyframes[0]));
+}
+
+TEST_CASE("TSFrameExtractor resumes forward after a backward jump without seeking again", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.reverse_buffer_bytes = 64 * 1024 * 1024;
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 2);
+  const auto target = static_cast<size_t>(keyframes[1] + 3);
+  REQUIRE(target + 1 < extractor.getTotalFrames());
+
+  // Warm up the buffer pool, leaving the decoder at the end of the file.
+  for (const size_t frame : { size_t{ 0 }, extractor.getTotalFrames() - 1 }) {
+    auto frame_data = extractor.getFrame(frame);
+    REQUIRE(frame_data.has_value());
+    extractor.recycleFrame(std::move(frame_data.value()));
+  }
+
+  // A jump back is a single seek, not a reverse playback buffer fill, and the next frame
+  // is decoded straight after it.
+  const auto before = extractor.getDecodeStats();
+  auto frame_data = extractor.getFrame(target);
+  REQUIRE(frame_data.has_value());
+  extractor.recycleFrame(std::move(frame_data.value()));
+  const size_t decoded_after_jump = extractor.getDecodeStats().frames_decoded;
+
+  frame_data = extractor.getFrame(target + 1);
+  REQUIRE(frame_data.has_value());
+  extractor.recycleFrame(std::move(frame_data.value()));
+  const auto after = extractor.getDecodeStats();
+  REQUIRE(after.frames_decoded == decoded_after_jump + 1);
+  REQUIRE(after.buffer_allocations == before.buffer_allocations);
+}
+
+TEST_CASE("TSFrameExtractor batch retrieval decodes each GOP once", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  TSFrameExtractor reference(FILE_PATH_TS, options);
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  // Every 10th frame of the first GOPs, unordered and with a duplicate.
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 3);
+  std::vector<size_t> indices;
+  for (size_t frame = 0; frame < static_cast<size_t>(keyframes[2]); frame += 10) { indices.push_back(frame); }
+  std::reverse(indices.begin(), indices.end());
+  indices.push_back(indices.front());
+
+  const auto frames = extractor.getFrames(indices);
+  REQUIRE(frames.size() == indices.size());
+  for (size_t position = 0; position < indices.size(); ++position) {
+    REQUIRE(frames[position] == reference.getFrame(indices[position]));
+  }
+  REQUIRE(extractor.getDecodeStats().frames_decoded <= static_cast<size_t>(keyframes[2]));
+
+  // The streaming variant delivers frames in ascending order.
+  std::vector<size_t> delivered;
+  extractor.getFrames(0, static_cast<size_t>(keyframes[1]), 7, [&](size_t frame, std::vector<uint8_t> &&data) {
+    delivered.push_back(frame);
+    extractor.recycleFrame(std::move(data));
+  });
+  REQUIRE(std::is_sorted(delivered.begin(), delivered.end()));
+  REQUIRE(delivered.size() == (static_cast<size_t>(keyframes[1]) + 6) / 7);
+
+  REQUIRE_THROWS_AS(extractor.getFrames({ extractor.getTotalFrames() }), std::out_of_range);
+}
+
+TEST_CASE("TSGrabber batch retrieval matches single frames", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+
+  const std::vector<size_t> indices = { 40, 5, 90, 5 };
+  const auto frames = grabber.getCvFrames(indices);
+  REQUIRE(frames.size() == indices.size());
+  for (size_t position = 0; position < indices.size(); ++position) {
+    const cv::Mat expected = grabber.getCvFrame(indices[position]);
+    REQUIRE(cv::countNonZero(frames[position] != expected) == 0);
+  }
+
+  // The callback runs outside the grabber's lock, so it can read other frames.
+  std::vector<size_t> delivered;
+  grabber.getCvFrames({ 3, 60, 30, 61, 62, 63, 64, 65, 66, 67, 68, 120 }, [&](size_t index, const cv::Mat &frame) {
+    delivered.push_back(index);
+    REQUIRE(cv::norm(frame, grabber.getCvFrame(index), cv::NORM_INF) == 0);
+  });
+  REQUIRE(delivered == std::vector<size_t>{ 3, 30, 60, 61, 62, 63, 64, 65, 66, 67, 68, 120 });
+}
+
+TEST_CASE("TSParallelDecoder sweeps segments on several workers", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  TSFrameExtractor source(FILE_PATH_TS, options);
+
+  const auto keyframes = source.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 4);
+  const auto last = static_cast<size_t>(keyframes[3] + 3);
+
+  // Sequential reference of the range.
+  std::vector<std::vector<uint8_t>> expected;
+  for (size_t frame = 0; frame < last; ++frame) { expected.push_back(source.getFrame(frame).value()); }
+
+  TSParallelDecoder::Options sweep_options;
+  sweep_options.workers = 3;
+  sweep_options.reorder_capacity = 8;
+  sweep_options.output_format = netxten::types::PixelFormat::GRAY8;
+
+  SECTION("ordered delivery")
+  {
+    TSParallelDecoder decoder(source, sweep_options);
+    REQUIRE(decoder.getWorkerCount() == 3);
+    size_t next = 0;
+    const size_t delivered = decoder.run(0, last, [&](size_t frame, std::vector<uint8_t> &&data) {
+      REQUIRE(frame == next);
+      REQUIRE(data == expected[frame]);
+      ++next;
+    });
+    REQUIRE(delivered == last);
+  }
+
+  SECTION("unordered delivery")
+  {
+    sweep_options.delivery = TSParallelDecoder::Delivery::UNORDERED;
+    TSParallelDecoder decoder(source, sweep_options);
+    std::mutex mutex;
+    std::vector<bool> seen(last, false);
+    bool matches = true;
+    decoder.run(0, last, [&](size_t frame, std::vector<uint8_t> &&data) {
+      std::lock_guard<std::mutex> lock(mutex);
+      seen[frame] = true;
+      matches = matches && data == expected[frame];
+    });
+    REQUIRE(matches);
+    REQUIRE(std::all_of(seen.begin(), seen.end(), [](bool value) { return value; }));
+  }
+}
+
+TEST_CASE("TSFrameExtractor decodes keyframe thumbnails", "[extractor]")
+{
+  TSFrameExtractor extractor(FILE_PATH_TS);
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 2);
+
+  const netxten::types::FrameSize size{ TS_HEIGHT / 4, 0 };
+  const size_t decoded_before = extractor.getDecodeStats().frames_decoded;
+  const auto thumbnails = extractor.getThumbnailStrip(keyframes.size() * 4, size);
+  REQUIRE_FALSE(thumbnails.empty());
+  REQUIRE(thumbnails.size() <= keyframes.size());
+  REQUIRE(extractor.getDecodeStats().frames_decoded - decoded_before == thumbnails.size());
+
+  const size_t expected_bytes = netxten::types::frameBufferSize(
+    netxten::types::PixelFormat::BGR24, { TS_HEIGHT / 4, TS_WIDTH / 4 });
+  for (size_t i = 0; i < thumbnails.size(); ++i) {
+    const auto &[frame, data] = thumbnails[i];
+    REQUIRE(std::find(keyframes.begin(), keyframes.end(), static_cast<int>(frame)) != keyframes.end());
+    REQUIRE(data.size() == expected_bytes);
+    if (i > 0) { REQUIRE(frame > thumbnails[i - 1].first); }
+  }
+
+  // The decode path still works after the demuxer was moved by the thumbnails.
+  REQUIRE(extractor.getFrame(1).has_value());
+}
+
+TEST_CASE("TSFrameExtractor scales frames to the output size", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  options.output_size = { 0, TS_WIDTH / 4 };
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  const auto frame = extractor.getFrame(5);
+  REQUIRE(frame.has_value());
+  const auto frame_size = extractor.getFrameSize();
+  REQUIRE(frame_size.has_value());
+  REQUIRE(frame_size->width == TS_WIDTH / 4);
+  REQUIRE(frame_size->height == TS_HEIGHT / 4);
+  REQUIRE(frame->size() == frame_size->width * frame_size->height);
+}
+
+TEST_CASE("TSGrabber switches to preview frames", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+
+  grabber.setPreviewSize({ TS_HEIGHT / 2, TS_WIDTH / 2 });
+  REQUIRE(grabber.getFrameSize() == std::make_pair(TS_HEIGHT / 2, TS_WIDTH / 2));
+  const cv::Mat preview = grabber.getCvFrame(10);
+  REQUIRE(preview.rows == TS_HEIGHT / 2);
+  REQUIRE(preview.cols == TS_WIDTH / 2);
+  REQUIRE(preview.type() == CV_16U);
+
+  grabber.setPreviewSize({});
+  REQUIRE(grabber.getFrameSize() == std::make_pair(TS_HEIGHT, TS_WIDTH));
+  REQUIRE(grabber.getCvFrame(10).rows == TS_HEIGHT);
+}
+
+TEST_CASE("TSFrameExtractor decodes from memory", "[extractor]")
+{
+  std::ifstream file(FILE_PATH_TS, std::ios::binary);
+  REQUIRE(file.is_open());
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  TSFrameExtractor::Options options;
+  options.memory_map = false;
+  TSFrameExtractor from_file(FILE_PATH_TS, options);
+  TSFrameExtractor mapped(FILE_PATH_TS);
+  TSFrameExtractor from_memory(data.data(), data.size());
+
+  REQUIRE(from_memory.getTotalFrames() == from_file.getTotalFrames());
+  REQUIRE(from_memory.getKeyframePositions() == from_file.getKeyframePositions());
+  for (const size_t frame : { size_t{ 0 }, size_t{ 17 }, from_file.getTotalFrames() - 1 }) {
+    const auto expected = from_file.getFrame(frame);
+    REQUIRE(expected.has_value());
+    REQUIRE(mapped.getFrame(frame) == expected);
+    REQUIRE(from_memory.getFrame(frame) == expected);
+  }
+
+  REQUIRE_THROWS_AS(TSFrameExtractor(data.data(), 0), std::invalid_argument);
+  REQUIRE(mapped.isMemoryMapped());
+  REQUIRE_FALSE(from_file.isMemoryMapped());
+}
+
+TEST_CASE("TSFrameExtractor falls back to the file protocol when mapping fails", "[extractor]")
+{
+  // A directory exists but cannot be mapped: the failure must come from opening the
+  // container through the file protocol, not from the mapping.
+  const auto directory = std::filesystem::temp_directory_path() / "test_repo_unmappable";
+  std::filesystem::create_directories(directory);
+  try {
+    TSFrameExtractor extractor(directory.string());
+    FAIL("Opening a directory as a video must fail");
+  } catch (const std::runtime_error &e) {
+    REQUIRE(std::string(e.what()).rfind("Failed to open video file", 0) == 0);
+  }
+  std::filesystem::remove(directory);
+}
+
+TEST_CASE("TSFrameExtractor follows a file that is being written", "[extractor]")
+{
+  std::ifstream source(FILE_PATH_TS, std::ios::binary);
+  REQUIRE(source.is_open());
+  const std::vector<char> data((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+  TSFrameExtractor reference(FILE_PATH_TS);
+  const size_t total_frames = reference.getTotalFrames();
+
+  const auto path = (std::filesystem::temp_directory_path() / "test_repo_follow.ts").string();
+  const size_t chunk = (data.size() / 8 + 187) / 188 * 188;
+  std::ofstream recording(path, std::ios::binary | std::ios::trunc);
+  recording.write(data.data(), static_cast<std::streamsize>(std::min(chunk * 2, data.size())));
+  recording.flush();
+
+  TSFrameExtractor::Options options;
+  options.follow = true;
+  options.follow_options.poll_interval = 0.01;
+  options.follow_options.idle_timeout = 1.0;
+  TSFrameExtractor follower(path, options);
+  REQUIRE(follower.isFollowing());
+
+  // Append the rest of the file while the extractor follows it.
+  std::thread writer([&]() {
+    for (size_t offset = chunk * 2; offset < data.size(); offset += chunk) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      recording.write(data.data() + offset, static_cast<std::streamsize>(std::min(chunk, data.size() - offset)));
+      recording.flush();
+    }
+  });
+
+  REQUIRE(follower.waitForFrames(total_frames, 10.0));
+  writer.join();
+  recording.close();
+  REQUIRE(follower.waitForIndex(10.0));
+  REQUIRE_FALSE(follower.isFollowing());
+  REQUIRE(follower.getTotalFrames() == total_frames);
+  REQUIRE(follower.getFrame(total_frames - 1) == reference.getFrame(total_frames - 1));
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("TSFrameExtractor decodes a followed file without waiting for the writer", "[extractor]")
+{
+  std::ifstream source(FILE_PATH_TS, std::ios::binary);
+  REQUIRE(source.is_open());
+  const std::vector<char> data((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+
+  const auto path = (std::filesystem::temp_directory_path() / "test_repo_follow_paused.ts").string();
+  const size_t chunk = (data.size() / 4 + 187) / 188 * 188;
+  {
+    std::ofstream recording(path, std::ios::binary | std::ios::trunc);
+    recording.write(data.data(), static_cast<std::streamsize>(std::min(chunk, data.size())));
+  }
+
+  // The writer is paused: the indexer waits at the end for up to the idle timeout.
+  TSFrameExtractor::Options options;
+  options.follow = true;
+  options.follow_options.poll_interval = 0.01;
+  options.follow_options.idle_timeout = 10.0;
+  TSFrameExtractor follower(path, options);
+  REQUIRE(follower.waitForFrames(1, 5.0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  REQUIRE(follower.isFollowing());
+
+  // The last indexed frame is decoded from the data written so far, not after the timeout.
+  const size_t last_indexed = follower.getTotalFrames() - 1;
+  const auto start = std::chrono::steady_clock::now();
+  REQUIRE(follower.getFrame(last_indexed).has_value());
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+  REQUIRE(follower.isFollowing());
+
+  follower.stopFollowing();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("TSFrameExtractor resolves frames by timestamp", "[extractor]")
+{
+  using Match = TSFrameExtractor::TimestampMatch;
+  TSFrameExtractor extractor(FILE_PATH_TS);
+  const size_t frame = 42;
+  const auto pts = extractor.getFramePts(frame);
+  const auto next_pts = extractor.getFramePts(frame + 1);
+  REQUIRE(pts.has_value());
+  REQUIRE(next_pts.has_value());
+  REQUIRE(next_pts.value() > pts.value());
+
+  REQUIRE(extractor.findFrameByPts(pts.value()) == frame);
+  REQUIRE(extractor.findFrameByPts(pts.value() + 1, Match::AT_OR_BEFORE) == frame);
+  REQUIRE(extractor.findFrameByPts(next_pts.value() - 1, Match::NEAREST) == frame + 1);
+  if (next_pts.value() - pts.value() > 1) { REQUIRE_FALSE(extractor.findFrameByPts(pts.value() + 1).has_value()); }
+
+  const auto seconds = extractor.getFrameTime(frame);
+  REQUIRE(seconds.has_value());
+  REQUIRE(extractor.findFrameAtTime(seconds.value()) == frame);
+  REQUIRE(extractor.getFrameAtTime(seconds.value()) == extractor.getFrame(frame));
+  REQUIRE(extractor.getFrameByPts(pts.value()) == extractor.getFrame(frame));
+}
+
+TEST_CASE("TSExtractorPool serves concurrent readers", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  TSFrameExtractor source(FILE_PATH_TS, options);
+  const size_t total_frames = source.getTotalFrames();
+
+  std::vector<size_t> frames;
+  for (size_t frame = 3; frame < total_frames; frame += total_frames / 16 + 1) { frames.push_back(frame); }
+  std::vector<std::vector<uint8_t>> expected;
+  for (const size_t frame : frames) { expected.push_back(source.getFrame(frame).value()); }
+
+  SECTION("extractor pool")
+  {
+    TSExtractorPool pool(source, 4, options);
+    std::atomic<bool> matches{ true };
+    std::vector<std::thread> readers;
+    for (size_t reader = 0; reader < 4; ++reader) {
+      readers.emplace_back([&, reader]() {
+        for (size_t i = reader; i < frames.size() * 4; i += 4) {
+          auto frame = pool.getFrame(frames[i % frames.size()]);
+          if (!frame.has_value() || frame.value() != expected[i % frames.size()]) { matches = false; }
+          if (frame.has_value()) { pool.recycleFrame(std::move(frame.value())); }
+        }
+      });
+    }
+    for (auto &reader : readers) { reader.join(); }
+    REQUIRE(matches);
+    REQUIRE(pool.getStats().contexts <= 4);
+    REQUIRE(pool.getStats().requests == frames.size() * 4);
+  }
+
+  SECTION("grabber readers")
+  {
+    TSGrabber grabber(FILE_PATH_TS, true, false);
+    grabber.initialize();
+    std::vector<cv::Mat> reference;
+    for (const size_t frame : frames) { reference.push_back(grabber.getCvFrame(frame)); }
+
+    grabber.setReaderCount(3);
+    std::atomic<bool> matches{ true };
+    std::vector<std::thread> readers;
+    for (size_t reader = 0; reader < 3; ++reader) {
+      readers.emplace_back([&, reader]() {
+        for (size_t i = reader; i < frames.size(); i += 3) {
+          if (cv::norm(grabber.getCvFrame(frames[i]), reference[i], cv::NORM_INF) != 0) { matches = false; }
+        }
+      });
+    }
+    for (auto &reader : readers) { reader.join(); }
+    REQUIRE(matches);
+  }
+}
+
+TEST_CASE("TSGrabber decodes into caller buffers", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  FrameBufferPool pool(grabber, 2);
+
+  // Consecutive frames reuse the pool's buffers instead of allocating.
+  const uint8_t *first_data = nullptr;
+  for (size_t index = 0; index < 20; ++index) {
+    auto buffer = pool.acquire();
+    const uint8_t *data = buffer.mat().data;
+    REQUIRE(grabber.getFrameInto(index, buffer.mat()));
+    REQUIRE(buffer.mat().data == data);
+    REQUIRE(cv::norm(buffer.mat(), grabber.getCvFrame(index), cv::NORM_INF) == 0);
+    if (index == 0) { first_data = data; }
+  }
+  REQUIRE(pool.getStats().allocations == 1);
+  REQUIRE(pool.acquire().mat().data == first_data);
+
+  // Raw buffers are written in place and checked for size.
+  std::vector<uint16_t> raw(TS_HEIGHT * TS_WIDTH);
+  REQUIRE(grabber.getFrameInto(7, raw.data(), raw.size()));
+  REQUIRE(raw == grabber.getFrame(7));
+  REQUIRE_FALSE(grabber.getFrameInto(7, raw.data(), raw.size() - 1));
+}
+
+TEST_CASE("TSGrabber serves cancellable asynchronous requests", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  const size_t total = grabber.getNumberOfFrames();
+  REQUIRE_THROWS_AS(grabber.requestCvFrame(total), std::out_of_range);
+
+  SECTION("queued requests all complete")
+  {
+    auto first = grabber.requestCvFrame(10);
+    auto second = grabber.requestCvFrame(total / 2);
+    REQUIRE(cv::norm(first.get(), grabber.getCvFrame(10), cv::NORM_INF) == 0);
+    REQUIRE(cv::norm(second.get(), grabber.getCvFrame(total / 2), cv::NORM_INF) == 0);
+    REQUIRE(grabber.getRequestStats().completed == 2);
+  }
+
+  SECTION("the latest request wins")
+  {
+    grabber.setRequestPolicy(TSGrabber::RequestPolicy::LATEST_WINS);
+    std::vector<std::future<cv::Mat>> requests;
+    for (size_t step = 1; step <= 8; ++step) { requests.push_back(grabber.requestCvFrame(total * step / 10)); }
+
+    // Superseded requests resolve to an empty image or, if they finished first, their frame.
+    for (size_t i = 0; i + 1 < requests.size(); ++i) {
+      const cv::Mat image = requests[i].get();
+      if (!image.empty()) { REQUIRE(cv::norm(image, grabber.getCvFrame(total * (i + 1) / 10), cv::NORM_INF) == 0); }
+    }
+    REQUIRE(cv::norm(requests.back().get(), grabber.getCvFrame(total * 8 / 10), cv::NORM_INF) == 0);
+
+    const auto stats = grabber.getRequestStats();
+    REQUIRE(stats.requests == 8);
+    REQUIRE(stats.completed + stats.cancelled == 8);
+    REQUIRE(stats.cancelled >= 1);
+  }
+
+  SECTION("a cancel flag abandons an extractor request")
+  {
+    TSFrameExtractor extractor(FILE_PATH_TS);
+    std::atomic<bool> cancel{ true };
+    REQUIRE_FALSE(extractor.getFrame(total / 2, cancel).has_value());
+    REQUIRE(extractor.getDecodeStats().frames_cancelled == 1);
+    cancel = false;
+    REQUIRE(extractor.getFrame(total / 2, cancel) == extractor.getFrame(total / 2));
+  }
+}
+
+TEST_CASE("TSFrameExtractor plans seeks against decoding forward", "[extractor]")
+{
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::GRAY8;
+  TSFrameExtractor reference(FILE_PATH_TS, options);
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+
+  // Keyframes are no longer thinned out, so every GOP has its own entry.
+  const auto keyframes = extractor.getKeyframePositions();
+  REQUIRE(keyframes.size() >= 3);
+  REQUIRE(std::adjacent_find(keyframes.begin(), keyframes.end()) == keyframes.end());
+
+  // A short jump ahead of the decoder is decoded forward without seeking.
+  REQUIRE(extractor.getFrame(0).has_value());
+  const size_t seeks_before = extractor.getDecodeStats().seeks;
+  REQUIRE(extractor.getFrame(3) == reference.getFrame(3));
+  REQUIRE(extractor.getDecodeStats().seeks == seeks_before);
+
+  // A far jump seeks, by byte offset for a transport stream.
+  const auto target = static_cast<size_t>(keyframes.back()) + 1;
+  REQUIRE(extractor.getFrame(target) == reference.getFrame(target));
+  REQUIRE(extractor.getDecodeStats().seeks == seeks_before + 1);
+  REQUIRE(extractor.getDecodeStats().byte_seeks == extractor.getDecodeStats().seeks);
+
+  // Seeking by timestamp returns the same frames.
+  options.byte_seek = false;
+  TSFrameExtractor timestamp_seeks(FILE_PATH_TS, options);
+  REQUIRE(timestamp_seeks.getFrame(target) == reference.getFrame(target));
+  REQUIRE(timestamp_seeks.getDecodeStats().byte_seeks == 0);
+}
+
+TEST_CASE("TSGrabber hands out shared frame views", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  const cv::Mat reference = grabber.getCvFrame(12);
+
+  const netxten::types::FrameView view = grabber.getFrameView(12);
+  REQUIRE(view.rows() == TS_HEIGHT);
+  REQUIRE(view.cols() == TS_WIDTH);
+  REQUIRE(view.type() == CV_16U);
+  REQUIRE(view.metadata().index == 12);
+  REQUIRE(view.metadata().pts.has_value());
+  REQUIRE(view.metadata().time.value() > 0.0);
+
+  // Copies and the cv::Mat, Eigen and row views all look at the same pixels.
+  const netxten::types::FrameView copy = view;
+  REQUIRE(copy.data() == view.data());
+  REQUIRE(view.mat().data == view.data());
+  REQUIRE(cv::norm(view.mat(), reference, cv::NORM_INF) == 0);
+
+  const auto map = view.map<uint16_t>();
+  REQUIRE(map.rows() == TS_HEIGHT);
+  REQUIRE(map.cols() == TS_WIDTH);
+  REQUIRE(map(5, 7) == reference.at<uint16_t>(5, 7));
+  REQUIRE(view.row<uint16_t>(5)[7] == reference.at<uint16_t>(5, 7));
+  REQUIRE_THROWS_AS(view.map<float>(), std::invalid_argument);
+
+  // Views made from a cv::Mat share its reference count.
+  const netxten::types::FrameView wrapped(reference.clone());
+  REQUIRE(wrapped.mat().u->refcount == 2);
+}
+
+TEST_CASE("TSGrabber frames map onto aligned row-major Eigen matrices", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  const cv::Mat reference = grabber.getCvFrame(20);
+
+  // Views are aligned and map in their stored layout.
+  const netxten::types::FrameView view = grabber.getFrameView(20);
+  REQUIRE(view.isAligned());
+  const auto aligned = view.alignedMap<uint16_t>();
+  REQUIRE(aligned.rows() == TS_HEIGHT);
+  REQUIRE(aligned.cols() == TS_WIDTH);
+  REQUIRE(aligned(9, 11) == reference.at<uint16_t>(9, 11));
+  REQUIRE(aligned.cast<double>().sum() == cv::sum(reference)[0]);
+  REQUIRE(view.rowMajorMap<uint16_t>() == view.map<uint16_t>());
+
+  // Decoding straight into a row-major matrix keeps its storage.
+  netxten::types::RowMajorFrame16 frame(TS_HEIGHT, TS_WIDTH);
+  const uint16_t *data = frame.data();
+  REQUIRE(grabber.getFrameInto(20, frame));
+  REQUIRE(frame.data() == data);
+  REQUIRE(frame == aligned);
+
+  // An unaligned view is rejected by the aligned map only.
+  auto buffer = std::make_shared<std::vector<uint16_t>>(4 * 9);
+  const netxten::types::FrameView unaligned(buffer, buffer->data() + 1, 4, 8, 9 * sizeof(uint16_t), CV_16U);
+  REQUIRE_FALSE(unaligned.isAligned());
+  REQUIRE_THROWS_AS(unaligned.alignedMap<uint16_t>(), std::logic_error);
+  REQUIRE(unaligned.rowMajorMap<uint16_t>().rows() == 4);
+}
+
+TEST_CASE("BGR24 to Gray16 kernels match OpenCV", "[conversion]")
+{
+  // A random image with an odd width exercises the scalar tail of every kernel.
+  cv::Mat random(37, 101, CV_8UC3);
+  cv::randu(random, cv::Scalar::all(0), cv::Scalar::all(256));
+
+  TSFrameExtractor::Options options;
+  options.output_format = netxten::types::PixelFormat::BGR24;
+  TSFrameExtractor extractor(FILE_PATH_TS, options);
+  auto frame = extractor.getFrame(3);
+  REQUIRE(frame.has_value());
+  const cv::Mat decoded(TS_HEIGHT, TS_WIDTH, CV_8UC3, frame->data());
+
+  for (const cv::Mat &bgr : { random, decoded }) {
+    cv::Mat gray_8;
+    cv::cvtColor(bgr, gray_8, cv::COLOR_BGR2GRAY);
+    for (uint16_t scale : { uint16_t{ 257 }, uint16_t{ 1 } }) {
+      cv::Mat expected;
+      gray_8.convertTo(expected, CV_16U, scale);
+      for (auto level : { SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+        cv::Mat gray(bgr.rows, bgr.cols, CV_16U);
+        bgrToGray16(bgr.data, bgr.step[0], gray.ptr<uint16_t>(), gray.step[0], bgr.rows, bgr.cols, scale, level);
+        REQUIRE(cv::norm(gray, expected, cv::NORM_INF) == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("TSGrabber iterates over frame ranges", "[grabber]")
+{
+  TSGrabber grabber(FILE_PATH_TS);
+  grabber.initialize();
+  grabber.setPrefetchDepth(4);
+
+  // A consecutive range reads ahead from its first frame and reuses one buffer.
+  auto range = grabber.frames(10, 30);
+  REQUIRE(range.size() == 20);
+  size_t expected = 10;
+  const uint8_t *buffer = nullptr;
+  for (auto it = range.begin(); it != range.end(); ++it) {
+    REQUIRE(it.index() == expected);
+    REQUIRE(it->type() == CV_16U);
+    if (buffer == nullptr) { buffer = it->data; }
+    REQUIRE(it->data == buffer);
+    if (expected % 7 == 0) { REQUIRE(cv::norm(*it, grabber.getCvFrame(expected), cv::NORM_INF) == 0); }
+    ++expected;
+  }
+  REQUIRE(expected == 30);
+  REQUIRE(grabber.getPrefetchStats().hits > 0);
+
+  // Strided ranges stop at the last frame of the grabber.
+  const size_t total = grabber.getNumberOfFrames();
+  std::vector<size_t> visited;
+  auto strided = grabber.frames(total - 10, total + 100, 4);
+  for (auto it = strided.begin(); it != strided.end(); ++it) {
+    REQUIRE_FALSE(it->empty());
+    visited.push_back(it.index());
+  }
+  REQUIRE(visited == std::vector<size_t>{ total - 10, total - 6, total - 2 });
+  REQUIRE(strided.size() == 3);
+
+  // A postfix increment keeps the frame it was called on.
+  auto pair = grabber.frames(20, 22);
+  auto it = pair.begin();
+  const cv::Mat first = *it++;
+  REQUIRE(cv::norm(first, grabber.getCvFrame(20), cv::NORM_INF) == 0);
+  REQUIRE(it.index() == 21);
+  REQUIRE(cv::norm(*it, grabber.getCvFrame(21), cv::NORM_INF) == 0);
+
+  size_t count = 0;
+  for (const cv::Mat &frame : grabber.frames()) {
+    REQUIRE(frame.rows == TS_HEIGHT);
+    ++count;
+  }
+  REQUIRE(count == total);
+
+  REQUIRE(grabber.frames(5, 5).empty());
+  REQUIRE_THROWS_AS(grabber.frames(0, 10, 0), std::invalid_argument);
+  REQUIRE_THROWS_AS(grabber.frames(total + 1, total + 2), std::out_of_range);
+}
+
+TEST_CASE("RawGrabber serves memory-mapped raw frames", "[grabber]")
+{
+  // Dump a few decoded frames as a raw file with a file header, per-frame headers and a torn last frame.
+  TSGrabber source(FILE_PATH_TS);
+  source.initialize();
+  RawGrabber::Layout layout;
+  layout.rows = TS_HEIGHT;
+  layout.cols = TS_WIDTH;
+  layout.header_bytes = 64;
+  layout.frame_header_bytes = 16;
+
+  const auto path = (std::filesystem::temp_directory_path() / "test_repo_frames.raw").string();
+  std::vector<cv::Mat> expected;
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const std::vector<char> header(layout.header_bytes, 'H');
+    const std::vector<char> frame_header(layout.frame_header_bytes, 'F');
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    for (size_t index = 0; index < 6; ++index) {
+      expected.push_back(source.getCvFrame(index * 5));
+      file.write(frame_header.data(), static_cast<std::streamsize>(frame_header.size()));
+      file.write(reinterpret_cast<const char *>(expected.back().data),
+        static_cast<std::streamsize>(expected.back().total() * expected.back().elemSize()));
+    }
+    file.write(frame_header.data(), static_cast<std::streamsize>(frame_header.size()));
+  }
+
+  netxten::types::FrameView view;
+  {
+    RawGrabber grabber(path, layout);
+    grabber.initialize();
+    REQUIRE(grabber.getNumberOfFrames() == expected.size());
+    REQUIRE(grabber.getFrameSize() == std::make_pair(TS_HEIGHT, TS_WIDTH));
+
+    // Random access, copies and zero-copy views all see the stored frames.
+    for (const size_t index : { size_t{ 4 }, size_t{ 0 }, size_t{ 5 } }) {
+      REQUIRE(cv::norm(grabber.getCvFrame(index), expected[index], cv::NORM_INF) == 0);
+      REQUIRE(grabber.getFrame(index).size() == static_cast<size_t>(TS_HEIGHT * TS_WIDTH));
+    }
+    view = grabber.getFrameView(3);
+    REQUIRE(view.metadata().index == 3);
+    REQUIRE(grabber.getFrameView(3).data() == view.data());
+    REQUIRE_THROWS_AS(grabber.getCvFrame(expected.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(grabber.getFrameView(expected.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(grabber.getFrame(expected.size()), std::out_of_range);
+
+    size_t index = 0;
+    for (const cv::Mat &frame : grabber.frames()) {
+      REQUIRE(cv::norm(frame, expected[index], cv::NORM_INF) == 0);
+      ++index;
+    }
+    REQUIRE(index == expected.size());
+  }
+
+  // The view keeps the mapping alive after the grabber is gone.
+  REQUIRE(cv::norm(view.mat(), expected[3], cv::NORM_INF) == 0);
+  view = netxten::types::FrameView{};
+  std::filesystem::remove(path);
+
+  layout.header_bytes = 3;
+  REQUIRE_THROWS_AS(RawGrabber(path, layout), std::invalid_argument);
+}